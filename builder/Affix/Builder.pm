@@ -77,11 +77,12 @@ class    #
         #~ }
         my %modules       = map { $_ => catfile( 'blib', $_ ) } find( qr/\.pm$/,  'lib' );
         my %docs          = map { $_ => catfile( 'blib', $_ ) } find( qr/\.pod$/, 'lib' );
+        my %headers       = map { $_ => catfile( 'blib', $_ ) } find( qr/\.h$/,   'lib/Affix' );
         my %scripts       = map { $_ => catfile( 'blib', $_ ) } find( qr/(?:)/,   'script' );
         my %sdocs         = map { $_ => delete $scripts{$_} } grep {/.pod$/} keys %scripts;
         my %dist_shared   = map { $_ => catfile( qw[blib lib auto share dist],   $meta->name, abs2rel( $_, 'share' ) ) } find( qr/(?:)/, 'share' );
         my %module_shared = map { $_ => catfile( qw[blib lib auto share module], abs2rel( $_, 'module-share' ) ) } find( qr/(?:)/, 'module-share' );
-        pm_to_blib( { %modules, %docs, %scripts, %dist_shared, %module_shared }, catdir(qw[blib lib auto]) );
+        pm_to_blib( { %modules, %docs, %headers, %scripts, %dist_shared, %module_shared }, catdir(qw[blib lib auto]) );
         make_executable($_) for values %scripts;
         make_path( catdir(qw[blib arch]), { chmod => 0777, verbose => $verbose } );
         0;
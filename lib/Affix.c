@@ -1,14 +1,87 @@
 #include "Affix.h"
+#include <float.h>
 #include <string.h>
 
+// Inline SV -> C scalar conversion, shared by the plan VM and the direct marshallers.
+// A plain IV or NV without get-magic is a flags test and one load from the SV body; anything
+// else (strings, magic, overloading) takes an out-of-line call that stays off the hot path.
+#if defined(__GNUC__) || defined(__clang__)
+#define AFFIX_COLD __attribute__((cold, noinline))
+#else
+#define AFFIX_COLD
+#endif
+static AFFIX_COLD IV _affix_sv_iv_slow(pTHX_ SV * sv) { return SvIV(sv); }
+static AFFIX_COLD UV _affix_sv_uv_slow(pTHX_ SV * sv) { return SvUV(sv); }
+static AFFIX_COLD NV _affix_sv_nv_slow(pTHX_ SV * sv) { return SvNV(sv); }
+PERL_STATIC_INLINE IV _affix_sv_iv(pTHX_ SV * sv) {
+    if (LIKELY((SvFLAGS(sv) & (SVf_IOK | SVs_GMG)) == SVf_IOK))
+        return SvIVX(sv);
+    return _affix_sv_iv_slow(aTHX_ sv);
+}
+PERL_STATIC_INLINE UV _affix_sv_uv(pTHX_ SV * sv) {
+    if (LIKELY((SvFLAGS(sv) & (SVf_IOK | SVs_GMG)) == SVf_IOK))
+        return SvUVX(sv);
+    return _affix_sv_uv_slow(aTHX_ sv);
+}
+PERL_STATIC_INLINE NV _affix_sv_nv(pTHX_ SV * sv) {
+    U32 flags = SvFLAGS(sv);
+    if (LIKELY((flags & (SVf_NOK | SVs_GMG)) == SVf_NOK))
+        return SvNVX(sv);
+    // Integer literals like 0 or 1 are common for float parameters.
+    if ((flags & (SVf_IOK | SVs_GMG)) == SVf_IOK)
+        return (flags & SVf_IVisUV) ? (NV)SvUVX(sv) : (NV)SvIVX(sv);
+    return _affix_sv_nv_slow(aTHX_ sv);
+}
+
 // Test: Direct Marshalling Handlers
-static infix_direct_value_t affix_marshaller_sint(void * sv_raw);
-static infix_direct_value_t affix_marshaller_uint(void * sv_raw);
-static infix_direct_value_t affix_marshaller_double(void * sv_raw);
-static infix_direct_value_t affix_marshaller_pointer(void * sv_raw);
-static void affix_aggregate_marshaller(void * sv_raw, void * dest, const infix_type * type);
-static void affix_aggregate_writeback(void * sv_raw, void * src, const infix_type * type);
+static infix_direct_value_t affix_marshaller_sint(void * arg_raw);
+static infix_direct_value_t affix_marshaller_uint(void * arg_raw);
+static infix_direct_value_t affix_marshaller_double(void * arg_raw);
+static infix_direct_value_t affix_marshaller_pointer(void * arg_raw);
+static void affix_aggregate_marshaller(void * arg_raw, void * dest, const infix_type * type);
+static void affix_aggregate_writeback(void * arg_raw, void * src, const infix_type * type);
+static infix_direct_value_t affix_marshaller_bool(void * arg_raw);
+static infix_direct_value_t affix_marshaller_sv(void * arg_raw);
+static infix_direct_value_t affix_marshaller_callback(void * arg_raw);
 static infix_direct_arg_handler_t get_direct_handler_for_type(const infix_type * type);
+static Affix_Type * _type_intern_graph(pTHX_ const infix_type * type);
+static void _pin_set_type(Affix_Pin * pin, Affix_Type * ref);
+
+/// @brief Classifies a return type for the switch in Affix_trigger_backend().
+static Affix_Ret_Kind _direct_ret_kind(const infix_type * type) {
+    if (type->category == INFIX_TYPE_VOID)
+        return AFFIX_RET_VOID;
+    if (type->category == INFIX_TYPE_ENUM)
+        return _direct_ret_kind(type->meta.enum_info.underlying_type);
+    if (type->category != INFIX_TYPE_PRIMITIVE)
+        return AFFIX_RET_OTHER;
+    switch (type->meta.primitive_id) {
+    case INFIX_PRIMITIVE_BOOL:
+        return AFFIX_RET_BOOL;
+    case INFIX_PRIMITIVE_SINT8:
+        return AFFIX_RET_SINT8;
+    case INFIX_PRIMITIVE_UINT8:
+        return AFFIX_RET_UINT8;
+    case INFIX_PRIMITIVE_SINT16:
+        return AFFIX_RET_SINT16;
+    case INFIX_PRIMITIVE_UINT16:
+        return AFFIX_RET_UINT16;
+    case INFIX_PRIMITIVE_SINT32:
+        return AFFIX_RET_SINT32;
+    case INFIX_PRIMITIVE_UINT32:
+        return AFFIX_RET_UINT32;
+    case INFIX_PRIMITIVE_SINT64:
+        return AFFIX_RET_SINT64;
+    case INFIX_PRIMITIVE_UINT64:
+        return AFFIX_RET_UINT64;
+    case INFIX_PRIMITIVE_FLOAT:
+        return AFFIX_RET_FLOAT;
+    case INFIX_PRIMITIVE_DOUBLE:
+        return AFFIX_RET_DOUBLE;
+    default:
+        return AFFIX_RET_OTHER;
+    }
+}
 
 /**
  * @brief The XSUB trigger for high-performance "bundled" trampolines.
@@ -21,10 +94,10 @@ static infix_direct_arg_handler_t get_direct_handler_for_type(const infix_type *
  * 1.  Validates the number of arguments passed from Perl.
  * 2.  Allocates a temporary buffer on the stack for the C function's return value.
  * 3.  Calls the JIT-compiled `cif` function directly, passing it a pointer to the
- *     return buffer and a pointer to the start of the Perl stack frame (`&ST(0)`),
- *     which the JIT code treats as the `void** lang_objects_array`.
- * 4.  After the call, it invokes the pre-resolved "pull" handler to convert the
- *     C return value into a Perl SV.
+ *     return buffer and an array of Affix_Direct_Arg cookies, which the JIT code treats
+ *     as the `void** lang_objects_array` and hands back to our marshallers one by one.
+ * 4.  After the call, scalar results are stored straight into TARG by return kind;
+ *     anything else goes through the pre-resolved "pull" handler.
  * 5.  Pushes the resulting SV onto the Perl stack as the return value.
  */
 void Affix_trigger_backend(pTHX_ CV * cv) {
@@ -42,21 +115,90 @@ void Affix_trigger_backend(pTHX_ CV * cv) {
               (UV)backend->num_args,
               (UV)(SP - MARK));
 
-    // Allocate a buffer on the C stack for the return value. `alloca` is fast and
-    // is automatically cleaned up when this function returns.
-    void * ret_buffer =  // safemalloc(sizeof(double));
-        alloca(infix_type_get_size(backend->ret_type));
-
-    // Get a pointer to the start of the Perl argument stack.
-    SV ** perl_stack_frame = &ST(0);
+    // Scalar results land in a local; only aggregates need a buffer sized at runtime.
+    union {
+        int8_t s8;
+        uint8_t u8;
+        int16_t s16;
+        uint16_t u16;
+        int32_t s32;
+        uint32_t u32;
+        int64_t s64;
+        uint64_t u64;
+        float f;
+        double d;
+        bool b;
+        void * p;
+    } scalar_ret;
+    void * ret_buffer =
+        backend->ret_kind != AFFIX_RET_OTHER ? (void *)&scalar_ret : alloca(infix_type_get_size(backend->ret_type));
+
+    // Pair each argument with the interpreter so the marshallers never need dTHX.
+    Affix_Direct_Arg * cookies = (Affix_Direct_Arg *)alloca((backend->num_args + 1) * sizeof(Affix_Direct_Arg));
+    void ** lang_objects = (void **)alloca((backend->num_args + 1) * sizeof(void *));
+    for (size_t i = 0; i < backend->num_args; ++i) {
+        cookies[i].sv = ST(i);
+        storeTHX(cookies[i].perl);
+        cookies[i].type = backend->arg_types[i];
+        cookies[i].writeback = NULL;
+        lang_objects[i] = &cookies[i];
+    }
 
     // Call the high-performance JIT-compiled trampoline.
-    backend->cif(ret_buffer, (void **)perl_stack_frame);
+    backend->cif(ret_buffer, lang_objects);
+
+    // Scalar out-parameters were pointed at their cookie's scratch space; copy them back.
+    if (backend->has_pointer_args)
+        for (size_t i = 0; i < backend->num_args; ++i)
+            if (cookies[i].writeback)
+                cookies[i].writeback(aTHX_ &cookies[i]);
 
     // 2. Marshal C -> Perl directly into TARG.
     // TARG is already an SV* managed by Perl.
     // If it's 'my $x', we are writing directly into $x's memory. No allocation.
-    backend->pull_handler(aTHX_ NULL, TARG, backend->ret_type, ret_buffer);
+    // TARGi/TARGu/TARGn set the body and flags in place when TARG is a plain scalar.
+    switch (backend->ret_kind) {
+    case AFFIX_RET_SINT8:
+        TARGi((IV)scalar_ret.s8, 1);
+        break;
+    case AFFIX_RET_UINT8:
+        TARGu((UV)scalar_ret.u8, 1);
+        break;
+    case AFFIX_RET_SINT16:
+        TARGi((IV)scalar_ret.s16, 1);
+        break;
+    case AFFIX_RET_UINT16:
+        TARGu((UV)scalar_ret.u16, 1);
+        break;
+    case AFFIX_RET_SINT32:
+        TARGi((IV)scalar_ret.s32, 1);
+        break;
+    case AFFIX_RET_UINT32:
+        TARGu((UV)scalar_ret.u32, 1);
+        break;
+    case AFFIX_RET_SINT64:
+        TARGi((IV)scalar_ret.s64, 1);
+        break;
+    case AFFIX_RET_UINT64:
+        TARGu((UV)scalar_ret.u64, 1);
+        break;
+    case AFFIX_RET_FLOAT:
+        TARGn((NV)scalar_ret.f, 1);
+        break;
+    case AFFIX_RET_DOUBLE:
+        TARGn((NV)scalar_ret.d, 1);
+        break;
+    case AFFIX_RET_BOOL:
+        sv_setbool(TARG, scalar_ret.b);
+        break;
+    case AFFIX_RET_VOID:
+        ST(0) = &PL_sv_undef;
+        PL_stack_sp = PL_stack_base + ax;
+        return;
+    default:
+        backend->pull_handler(aTHX_ NULL, TARG, backend->ret_type, ret_buffer);
+        break;
+    }
 
     // 3. Return TARG.
     // We don't need sv_2mortal because dXSTARG handles the lifecycle flags.
@@ -67,122 +209,210 @@ void Affix_trigger_backend(pTHX_ CV * cv) {
 /**
  * @brief The marshaller for all primitive integer types.
  */
-static infix_direct_value_t affix_marshaller_sint(void * sv_raw) {
-    dTHX;
+static infix_direct_value_t affix_marshaller_sint(void * arg_raw) {
+    Affix_Direct_Arg * arg = (Affix_Direct_Arg *)arg_raw;
+    dTHXa(arg->perl);
     infix_direct_value_t val;
-    val.i64 = SvIV((SV *)sv_raw);
+    val.i64 = _affix_sv_iv(aTHX_ arg->sv);
     return val;
 }
 
 /**
  * @brief The marshaller for all primitive unsigned integer types.
  */
-static infix_direct_value_t affix_marshaller_uint(void * sv_raw) {
-    dTHX;
+static infix_direct_value_t affix_marshaller_uint(void * arg_raw) {
+    Affix_Direct_Arg * arg = (Affix_Direct_Arg *)arg_raw;
+    dTHXa(arg->perl);
     infix_direct_value_t val;
-    val.u64 = SvUV((SV *)sv_raw);
+    val.u64 = _affix_sv_uv(aTHX_ arg->sv);
     return val;
 }
 
 /**
  * @brief The marshaller for all primitive floating-point types.
  */
-static infix_direct_value_t affix_marshaller_double(void * sv_raw) {
+static infix_direct_value_t affix_marshaller_double(void * arg_raw) {
+    Affix_Direct_Arg * arg = (Affix_Direct_Arg *)arg_raw;
+    dTHXa(arg->perl);
     infix_direct_value_t val;
-    SV * sv = (SV *)sv_raw;
-    U32 flags = SvFLAGS(sv);  // Single memory read
-
-    // Optimization: Float is the expected type, check it first.
-    if (LIKELY(flags & SVf_NOK)) {
-        val.f64 = SvNVX(sv);
-    }
-    // Fallback: Integer types (common for literals like '0' or '1')
-    else if (flags & SVf_IOK) {
-        // Check the "Is UV" bit directly from our cached flags
-        if (flags & SVf_IVisUV)
-            val.f64 = (double)SvUVX(sv);
-        else
-            val.f64 = (double)SvIVX(sv);
-    }
-    // Slow path: Strings ("3.14"), References, Overloaded objects
-    else {
-        dTHX;  // Required for SvNV fallback
-        val.f64 = (double)SvNV(sv);
-    }
+    val.f64 = (double)_affix_sv_nv(aTHX_ arg->sv);
+    return val;
+}
+/**
+ * @brief The marshaller for `bool`, which follows Perl's notion of truth.
+ */
+static infix_direct_value_t affix_marshaller_bool(void * arg_raw) {
+    Affix_Direct_Arg * arg = (Affix_Direct_Arg *)arg_raw;
+    dTHXa(arg->perl);
+    infix_direct_value_t val;
+    val.i64 = SvTRUE(arg->sv) ? 1 : 0;
+    return val;
+}
+
+/**
+ * @brief The marshaller for arguments of the `@SV` type: C receives the SV* itself.
+ */
+static infix_direct_value_t affix_marshaller_sv(void * arg_raw) {
+    Affix_Direct_Arg * arg = (Affix_Direct_Arg *)arg_raw;
+    infix_direct_value_t val;
+    SvREFCNT_inc_simple_void_NN(arg->sv);
+    val.ptr = arg->sv;
+    return val;
+}
 
+/**
+ * @brief The marshaller for function pointer arguments.
+ */
+static infix_direct_value_t affix_marshaller_callback(void * arg_raw) {
+    Affix_Direct_Arg * arg = (Affix_Direct_Arg *)arg_raw;
+    dTHXa(arg->perl);
+    infix_direct_value_t val;
+    const infix_type * type = arg->type->category == INFIX_TYPE_POINTER ? arg->type->meta.pointer_info.pointee_type
+                                                                         : arg->type;
+    push_reverse_trampoline(aTHX_ NULL, type, arg->sv, &val.ptr);
     return val;
 }
+
+/// @brief Copies a scalar C changed through a pointer back into the referenced Perl scalar.
+static void _direct_writeback_scalar(pTHX_ Affix_Direct_Arg * arg) {
+    ptr2sv(aTHX_ NULL, &arg->scratch, SvRV(arg->sv), arg->pointee);
+}
+/// @brief Copies the string a `**char` argument points at back into the referenced Perl scalar.
+static void _direct_writeback_string(pTHX_ Affix_Direct_Arg * arg) { sv_setpv(SvRV(arg->sv), (char *)arg->scratch.ptr); }
+
+/**
+ * @brief The out-of-line half of affix_marshaller_pointer(): references and everything unusual.
+ *
+ * Scalar references point C at the argument's scratch space and register a writeback, so
+ * `*int` and `**char` out-parameters work as they do with the plan VM. Array references are
+ * packed into a mortal buffer that lives until the caller's statement ends.
+ */
+static void * _direct_marshal_pointer_ref(pTHX_ Affix_Direct_Arg * arg) {
+    SV * sv = arg->sv;
+    const infix_type * pointee = arg->type->meta.pointer_info.pointee_type;
+    if (SvTYPE(sv) == SVt_PVCV || (SvROK(sv) && SvTYPE(SvRV(sv)) == SVt_PVCV)) {
+        if (pointee->category != INFIX_TYPE_REVERSE_TRAMPOLINE)
+            croak("Code reference passed for an argument that is not a callback");
+        void * code = NULL;
+        push_reverse_trampoline(aTHX_ NULL, pointee, sv, &code);
+        return code;
+    }
+    if (!SvROK(sv)) {
+        if (SvPOK(sv))
+            return (void *)SvPV_nolen(sv);
+        croak("Don't know how to pass this scalar as a pointer argument");
+    }
+    SV * rv = SvRV(sv);
+    if (SvTYPE(rv) == SVt_PVAV) {
+        AV * av = (AV *)rv;
+        size_t len = av_count(av);
+        size_t element_size = infix_type_get_size(pointee);
+        SV * buffer = sv_2mortal(newSV(len * element_size + 1));
+        char * c_array = SvPVX(buffer);
+        Zero(c_array, len * element_size, char);
+        for (size_t i = 0; i < len; ++i) {
+            SV ** elem_sv_ptr = av_fetch(av, i, 0);
+            if (elem_sv_ptr)
+                sv2ptr(aTHX_ NULL, *elem_sv_ptr, c_array + (i * element_size), pointee);
+        }
+        return c_array;
+    }
+    if (sv_isobject(sv))
+        // A blessed scalar holding an address, as many C libraries' Perl bindings use.
+        return INT2PTR(void *, SvIV(rv));
+    if (SvTYPE(rv) >= SVt_PVAV)
+        croak("Don't know how to pass this reference as a pointer argument");
+    // **char: C may point the string elsewhere.
+    if (pointee->category == INFIX_TYPE_POINTER && SvPOK(rv)) {
+        const infix_type * inner = pointee->meta.pointer_info.pointee_type;
+        if (inner->category == INFIX_TYPE_PRIMITIVE &&
+            (inner->meta.primitive_id == INFIX_PRIMITIVE_SINT8 || inner->meta.primitive_id == INFIX_PRIMITIVE_UINT8)) {
+            arg->scratch.ptr = SvPV_nolen(rv);
+            arg->writeback = _direct_writeback_string;
+            return &arg->scratch.ptr;
+        }
+    }
+    if (pointee->category == INFIX_TYPE_VOID) {
+        if (SvPOK(rv))
+            return (void *)SvPV_nolen(rv);
+        if (SvNOK(rv))
+            arg->scratch.f64 = SvNV(rv);
+        else if (SvIOK(rv))
+            arg->scratch.i64 = SvIV(rv);
+        else
+            croak("Cannot pass reference to this type of scalar for a 'void*' parameter");
+        return &arg->scratch;
+    }
+    if (infix_type_get_size(pointee) > sizeof(arg->scratch))
+        croak("Pointee is too large to pass by scalar reference");
+    sv2ptr(aTHX_ NULL, rv, &arg->scratch, pointee);
+    arg->pointee = pointee;
+    arg->writeback = _direct_writeback_scalar;
+    return &arg->scratch;
+}
+
 /**
- * @brief The marshaller for all pointer types.
+ * @brief The marshaller for all pointer types that are not pointers to aggregates.
  */
-static infix_direct_value_t affix_marshaller_pointer(void * sv_raw) {
-    dTHX;
+static infix_direct_value_t affix_marshaller_pointer(void * arg_raw) {
+    Affix_Direct_Arg * arg = (Affix_Direct_Arg *)arg_raw;
+    dTHXa(arg->perl);
     infix_direct_value_t val;
-    SV * sv = (SV *)sv_raw;
+    SV * sv = arg->sv;
     if (is_pin(aTHX_ sv))
         val.ptr = _get_pin_from_sv(aTHX_ sv)->pointer;
-    else if (SvPOK(sv))
+    else if (SvPOK(sv) && !SvROK(sv))
         val.ptr = (void *)SvPV_nolen(sv);
     else if (!SvOK(sv))
         val.ptr = NULL;
     else
-        // A simple fallback for other pointer types (e.g., passing a blessed object).
-        // A real binding would have more sophisticated logic here.
-        val.ptr = INT2PTR(void *, SvIV(SvRV(sv)));
+        val.ptr = _direct_marshal_pointer_ref(aTHX_ arg);
     return val;
 }
 
 /**
- * @brief A generic marshaller for all aggregate types (structs/unions).
+ * @brief A generic marshaller for aggregates: structs, unions and arrays, by value or behind a pointer.
  *
- * This function uses the `infix_type*` provided by the JIT trampoline to
- * introspect the C struct's layout. It iterates through the members and
- * recursively calls `sv2ptr` to populate the C struct buffer from a Perl hash.
+ * Perl data goes through `sv2ptr`. A pin is copied in, so C works on a private copy that the
+ * writeback handler copies back.
  */
-static void affix_aggregate_marshaller(void * sv_raw, void * dest_buffer, const infix_type * type) {
-    dTHX;
-    SV * sv = (SV *)sv_raw;
-    if (!SvROK(sv) || SvTYPE(SvRV(sv)) != SVt_PVHV) {
-        // For simplicity, we silently do nothing if not a hashref. A real binding
-        // might croak or warn here.
+static void affix_aggregate_marshaller(void * arg_raw, void * dest_buffer, const infix_type * type) {
+    Affix_Direct_Arg * arg = (Affix_Direct_Arg *)arg_raw;
+    dTHXa(arg->perl);
+    SV * sv = arg->sv;
+    if (is_pin(aTHX_ sv)) {
+        Copy(_get_pin_from_sv(aTHX_ sv)->pointer, dest_buffer, infix_type_get_size(type), char);
         return;
     }
-    HV * hv = (HV *)SvRV(sv);
-    for (size_t i = 0; i < infix_type_get_member_count(type); ++i) {
-        const infix_struct_member * member = infix_type_get_member(type, i);
-        if (member->name) {
-            SV ** member_sv_ptr = hv_fetch(hv, member->name, strlen(member->name), 0);
-            if (member_sv_ptr) {
-                void * member_ptr = (char *)dest_buffer + member->offset;
-                sv2ptr(aTHX_ NULL, *member_sv_ptr, member_ptr, member->type);
-            }
-        }
+    if (!SvOK(sv)) {
+        Zero(dest_buffer, infix_type_get_size(type), char);
+        return;
+    }
+    if (type->category == INFIX_TYPE_UNION) {
+        push_union(aTHX_ NULL, type, sv, dest_buffer);
+        return;
     }
+    sv2ptr(aTHX_ NULL, sv, dest_buffer, type);
 }
 
 /**
- * @brief A generic write-back handler for all aggregate types.
+ * @brief A generic write-back handler for aggregates passed by pointer.
  *
- * This function is the inverse of the marshaller. It uses the `infix_type*`
- * to iterate the C struct's members and updates the fields of the original
- * Perl hash with the (potentially modified) values from the C struct.
+ * The inverse of the marshaller: refreshes the original Perl hash or the pinned memory with
+ * whatever C left in the temporary copy.
  */
-static void affix_aggregate_writeback(void * sv_raw, void * src_buffer, const infix_type * type) {
-    dTHX;
-    SV * sv = (SV *)sv_raw;
-    if (!SvROK(sv) || SvTYPE(SvRV(sv)) != SVt_PVHV)
+static void affix_aggregate_writeback(void * arg_raw, void * src_buffer, const infix_type * type) {
+    Affix_Direct_Arg * arg = (Affix_Direct_Arg *)arg_raw;
+    dTHXa(arg->perl);
+    SV * sv = arg->sv;
+    if (is_pin(aTHX_ sv)) {
+        Copy(src_buffer, _get_pin_from_sv(aTHX_ sv)->pointer, infix_type_get_size(type), char);
         return;
-
-    HV * hv = (HV *)SvRV(sv);
-    for (size_t i = 0; i < infix_type_get_member_count(type); ++i) {
-        const infix_struct_member * member = infix_type_get_member(type, i);
-        if (member->name) {
-            void * member_ptr = (char *)src_buffer + member->offset;
-            SV * member_sv = newSV(0);
-            ptr2sv(aTHX_ NULL, member_ptr, member_sv, member->type);
-            hv_store(hv, member->name, strlen(member->name), member_sv, 0);
-        }
     }
+    if (!SvROK(sv))
+        return;
+    if (SvTYPE(SvRV(sv)) == SVt_PVHV && type->category == INFIX_TYPE_STRUCT)
+        _populate_hv_from_c_struct(aTHX_ NULL, (HV *)SvRV(sv), type, src_buffer);
 }
 
 /**
@@ -197,31 +427,36 @@ static infix_direct_arg_handler_t get_direct_handler_for_type(const infix_type *
     case INFIX_TYPE_PRIMITIVE:
         if (is_float(type) || is_double(type))
             h.scalar_marshaller = &affix_marshaller_double;
+        else if (type->meta.primitive_id == INFIX_PRIMITIVE_BOOL)
+            h.scalar_marshaller = &affix_marshaller_bool;
         else if (type->meta.primitive_id <= INFIX_PRIMITIVE_SINT128)
             h.scalar_marshaller = &affix_marshaller_sint;
         else
             h.scalar_marshaller = &affix_marshaller_uint;
         break;
+    case INFIX_TYPE_ENUM:
+        return get_direct_handler_for_type(type->meta.enum_info.underlying_type);
+    case INFIX_TYPE_REVERSE_TRAMPOLINE:
+        h.scalar_marshaller = &affix_marshaller_callback;
+        break;
     case INFIX_TYPE_POINTER:
         {
             const infix_type * pointee = type->meta.pointer_info.pointee_type;
-            if (pointee->category == INFIX_TYPE_STRUCT || pointee->category == INFIX_TYPE_UNION) {
+            const char * name = infix_type_get_name(type);
+            if (name && strnEQ(name, "SV", 2))
+                h.scalar_marshaller = &affix_marshaller_sv;
+            else if (pointee->category == INFIX_TYPE_STRUCT || pointee->category == INFIX_TYPE_UNION) {
                 h.aggregate_marshaller = &affix_aggregate_marshaller;
                 h.writeback_handler = &affix_aggregate_writeback;
             }
+            else if (pointee->category == INFIX_TYPE_REVERSE_TRAMPOLINE)
+                h.scalar_marshaller = &affix_marshaller_callback;
             else
                 h.scalar_marshaller = &affix_marshaller_pointer;
-            // TODO: Add a basic writeback for simple pointer types like *int.
-            // h.writeback_handler = ...
-
             break;
         }
-    case INFIX_TYPE_STRUCT:
-    case INFIX_TYPE_UNION:
-        h.aggregate_marshaller = &affix_aggregate_marshaller;
-        break;
     default:
-        // Other types like arrays-by-value are handled as aggregates.
+        // Structs, unions and arrays by value.
         h.aggregate_marshaller = &affix_aggregate_marshaller;
         break;
     }
@@ -254,32 +489,44 @@ typedef struct MockObject {
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //               FORWARD DECLARATIONS FOR STATIC FUNCTIONS
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-// Marshallers (Perl -> C)
-// Note: These functions must be `extern` (not static) so they can be
-// referenced by address from the language binding.
-int64_t affix_perl_shim_sv_to_sint64(pTHX_ void * sv_raw) { return SvIVX((SV *)sv_raw); }
-double affix_perl_shim_sv_to_double(pTHX_ void * sv_raw) { return SvNVX((SV *)sv_raw); }
-const char * affix_perl_shim_sv_to_string(pTHX_ void * sv_raw) { return SvPV_nolen((SV *)sv_raw); }
-void * affix_perl_shim_sv_to_pointer(pTHX_ void * sv_raw) {
-    SV * sv = (SV *)sv_raw;
-    if (!SvOK(sv) || !SvROK(sv))
-        return NULL;
-    // A proper implementation would check for Affix::Pin objects here.
-    // For now, we assume it's a raw pointer stored in the IV slot.
-    return INT2PTR(void *, SvIV(SvRV(sv)));
-}
-
-// Unmarshallers (C -> Perl) - Not used in this forward-call implementation
-void * affix_perl_shim_newSViv(pTHX_ int64_t value) { return newSViv(value); }
-void * affix_perl_shim_newSVnv(pTHX_ double value) { return newSVnv(value); }
-void * affix_perl_shim_newSVpv(pTHX_ const char * value) { return newSVpv(value, 0); }
-
 // Pin Management
 static int Affix_get_pin(pTHX_ SV * sv, MAGIC * mg);
 static int Affix_set_pin(pTHX_ SV * sv, MAGIC * mg);
 static U32 Affix_len_pin(pTHX_ SV * sv, MAGIC * mg);
 static int Affix_free_pin(pTHX_ SV * sv, MAGIC * mg);
 
+// Callback Lifecycle
+static int Affix_free_callbacks(pTHX_ SV * sv, MAGIC * mg);
+
+// ithreads: what a cloned interpreter gets in place of the parent's C state
+#ifdef USE_ITHREADS
+static int Affix_dup_pin(pTHX_ MAGIC * mg, CLONE_PARAMS * param);
+static int Affix_dup_callbacks(pTHX_ MAGIC * mg, CLONE_PARAMS * param);
+static int Affix_dup_binding(pTHX_ MAGIC * mg, CLONE_PARAMS * param);
+static int Affix_dup_lib(pTHX_ MAGIC * mg, CLONE_PARAMS * param);
+#define AFFIX_DUP(f) f
+#else
+#define AFFIX_DUP(f) NULL
+#endif
+static Affix_Callback_Data * _get_callback_user_data(pTHX_ SV * coderef_cv, SV * data_sv);
+static void _plan_shared_callbacks(pTHX_ Affix * affix);
+static void _destroy_affix(pTHX_ Affix * affix);
+static void _lib_registry_release(pTHX_ LibRegistryEntry * entry);
+static void _lib_registry_release_any(pTHX_ void * entry);
+static void _affix_core_release(pTHX_ Affix_Core * core);
+static void _shared_callback_release(pTHX_ Affix_Shared_Callback * shared);
+static LibRegistryEntry * _lib_entry_from_sv(pTHX_ SV * sv);
+static void _binding_set_dup(pTHX_ CV * cv);
+static bool _variadic_split(const char * signature, STRLEN * semi, STRLEN * close);
+static size_t _variadic_num_fixed(pTHX_ const char * signature, STRLEN semi, STRLEN close);
+static CV * _new_variadic_binding(
+    pTHX_ const char * signature, STRLEN semi, STRLEN close, void * symbol, const char * name);
+static void Affix_trigger_lazy(pTHX_ CV * cv);
+static CV * _new_lazy_binding(pTHX_ const char * signature, const char * symbol_name, void * symbol,
+                              HV * options, const char * name);
+static Affix * _lazy_resolve(pTHX_ CV * cv);
+static SV * _lazy_pure_error(pTHX_ const char * signature);
+
 // Execution Plan Step Executors
 static void plan_step_push_bool(pTHX_ Affix *, Affix_Plan_Step *, SV **, void *, void **, void *);
 static void plan_step_push_sint8(pTHX_ Affix *, Affix_Plan_Step *, SV **, void *, void **, void *);
@@ -306,6 +553,8 @@ static void plan_step_push_complex(pTHX_ Affix *, Affix_Plan_Step *, SV **, void
 static void plan_step_push_vector(pTHX_ Affix *, Affix_Plan_Step *, SV **, void *, void **, void *);
 static void plan_step_push_sv(pTHX_ Affix *, Affix_Plan_Step *, SV **, void *, void **, void *);
 static void plan_step_push_callback(pTHX_ Affix *, Affix_Plan_Step *, SV **, void *, void **, void *);
+static void plan_step_push_shared_callback(pTHX_ Affix *, Affix_Plan_Step *, SV **, void *, void **, void *);
+static void plan_step_push_user_data(pTHX_ Affix *, Affix_Plan_Step *, SV **, void *, void **, void *);
 static void plan_step_call_c_function(pTHX_ Affix *, Affix_Plan_Step *, SV **, void *, void **, void *);
 static void plan_step_pull_return_value(pTHX_ Affix *, Affix_Plan_Step *, SV **, void *, void **, void *);
 
@@ -374,59 +623,25 @@ static void pull_uint128(pTHX_ Affix *, SV *, const infix_type *, void *);
         c_args[step->data.index] = c_arg_ptr;                             \
     }
 
-#define DEFINE_IV_PUSH_HANDLER(name, c_type)                                                 \
-    static void push_handler_##name(pTHX_ Affix * affix, SV * sv, void * c_ptr) {            \
-        PERL_UNUSED_VAR(affix);                                                              \
-        U32 flags = SvFLAGS(sv); /* Single memory read */                                    \
-        if (flags & SVf_IOK) {   /* Check the "Is IOK" bit directly from our cached flags */ \
-            if (flags & SVf_IVisUV)                                                          \
-                *(c_type *)c_ptr = (c_type)SvUVX(sv);                                        \
-            else                                                                             \
-                *(c_type *)c_ptr = (c_type)SvIVX(sv);                                        \
-        }                                                                                    \
-        else {                                                                               \
-            dTHX; /* Fallback */                                                             \
-            *(c_type *)c_ptr = (c_type)SvIV(sv);                                             \
-        }                                                                                    \
-        return;                                                                              \
-    }
-
-#define DEFINE_UV_PUSH_HANDLER(name, c_type)                                                \
-    static void push_handler_##name(pTHX_ Affix * affix, SV * sv, void * c_ptr) {           \
-        PERL_UNUSED_VAR(affix);                                                             \
-        U32 flags = SvFLAGS(sv); /* Single memory read */                                   \
-        if (flags & SVf_IOK) {   /* Check the "Is UV" bit directly from our cached flags */ \
-            if (flags & SVf_IVisUV)                                                         \
-                *(c_type *)c_ptr = (c_type)SvUVX(sv);                                       \
-            else                                                                            \
-                *(c_type *)c_ptr = (c_type)SvIVX(sv);                                       \
-        }                                                                                   \
-        else {                                                                              \
-            dTHX; /* Fallback */                                                            \
-            *(c_type *)c_ptr = (c_type)SvUV(sv);                                            \
-        }                                                                                   \
-        return;                                                                             \
-    }
-
-#define DEFINE_NV_PUSH_HANDLER(name, c_type)                                                                  \
-    static void push_handler_##name(pTHX_ Affix * affix, SV * sv, void * c_ptr) {                             \
-        PERL_UNUSED_VAR(affix);                                                                               \
-        U32 flags = SvFLAGS(sv); /* Single memory read */                                                     \
-        /* Optimization: Float is the expected type, check it first. */                                       \
-        if (LIKELY(flags & SVf_NOK))                                                                          \
-            *(c_type *)c_ptr = SvNVX(sv); /* Fallback: Integer types (common for literals like '0' or '1') */ \
-        else if (flags & SVf_IOK) {       /* Check the "Is UV" bit directly from our cached flags */          \
-            if (flags & SVf_IVisUV)                                                                           \
-                *(c_type *)c_ptr = (c_type)SvUVX(sv);                                                         \
-            else                                                                                              \
-                *(c_type *)c_ptr = (c_type)SvIVX(sv);                                                         \
-        } /* Slow path: Strings ("3.14"), References, Overloaded objects */                                   \
-        else {                                                                                                \
-            dTHX; /* Required for SvNV fallback */                                                            \
-            *(c_type *)c_ptr = (c_type)SvNV(sv);                                                              \
-        }                                                                                                     \
-        return;                                                                                               \
+#define DEFINE_IV_PUSH_HANDLER(name, c_type)                                      \
+    static void push_handler_##name(pTHX_ Affix * affix, SV * sv, void * c_ptr) { \
+        PERL_UNUSED_VAR(affix);                                                   \
+        *(c_type *)c_ptr = (c_type)_affix_sv_iv(aTHX_ sv);                        \
+    }
+#define DEFINE_UV_PUSH_HANDLER(name, c_type)                                      \
+    static void push_handler_##name(pTHX_ Affix * affix, SV * sv, void * c_ptr) { \
+        PERL_UNUSED_VAR(affix);                                                   \
+        *(c_type *)c_ptr = (c_type)_affix_sv_uv(aTHX_ sv);                        \
     }
+#define DEFINE_NV_PUSH_HANDLER(name, c_type)                                      \
+    static void push_handler_##name(pTHX_ Affix * affix, SV * sv, void * c_ptr) { \
+        PERL_UNUSED_VAR(affix);                                                   \
+        *(c_type *)c_ptr = (c_type)_affix_sv_nv(aTHX_ sv);                        \
+    }
+// Accessors for DEFINE_PUSH_PRIMITIVE_EXECUTOR that take the inline fast paths.
+#define AFFIX_SvIV(sv) _affix_sv_iv(aTHX_ sv)
+#define AFFIX_SvUV(sv) _affix_sv_uv(aTHX_ sv)
+#define AFFIX_SvNV(sv) _affix_sv_nv(aTHX_ sv)
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //              FUNCTION DEFINITIONS (BEFORE STATIC DATA)
@@ -483,6 +698,7 @@ static Affix_Opcode get_opcode_for_type(const infix_type * type) {
         return OP_PUSH_STRUCT;  // Fallback
     }
 }
+
 // Define sv2ptr primitive handlers
 DEFINE_IV_PUSH_HANDLER(sint8, int8_t)
 DEFINE_UV_PUSH_HANDLER(uint8, uint8_t)
@@ -503,17 +719,17 @@ static void push_handler_bool(pTHX_ Affix * affix, SV * perl_sv, void * c_ptr) {
 
 // Define primitive push executors
 DEFINE_PUSH_PRIMITIVE_EXECUTOR(bool, bool, SvTRUE)
-DEFINE_PUSH_PRIMITIVE_EXECUTOR(sint8, int8_t, SvIV)
-DEFINE_PUSH_PRIMITIVE_EXECUTOR(uint8, uint8_t, SvUV)
-DEFINE_PUSH_PRIMITIVE_EXECUTOR(sint16, int16_t, SvIV)
-DEFINE_PUSH_PRIMITIVE_EXECUTOR(uint16, uint16_t, SvUV)
-DEFINE_PUSH_PRIMITIVE_EXECUTOR(sint32, int32_t, SvIV)
-DEFINE_PUSH_PRIMITIVE_EXECUTOR(uint32, uint32_t, SvUV)
-DEFINE_PUSH_PRIMITIVE_EXECUTOR(sint64, int64_t, SvIV)
-DEFINE_PUSH_PRIMITIVE_EXECUTOR(uint64, uint64_t, SvUV)
-DEFINE_PUSH_PRIMITIVE_EXECUTOR(float, float, SvNV)
-DEFINE_PUSH_PRIMITIVE_EXECUTOR(double, double, SvNV)
-DEFINE_PUSH_PRIMITIVE_EXECUTOR(long_double, long double, SvNV)
+DEFINE_PUSH_PRIMITIVE_EXECUTOR(sint8, int8_t, AFFIX_SvIV)
+DEFINE_PUSH_PRIMITIVE_EXECUTOR(uint8, uint8_t, AFFIX_SvUV)
+DEFINE_PUSH_PRIMITIVE_EXECUTOR(sint16, int16_t, AFFIX_SvIV)
+DEFINE_PUSH_PRIMITIVE_EXECUTOR(uint16, uint16_t, AFFIX_SvUV)
+DEFINE_PUSH_PRIMITIVE_EXECUTOR(sint32, int32_t, AFFIX_SvIV)
+DEFINE_PUSH_PRIMITIVE_EXECUTOR(uint32, uint32_t, AFFIX_SvUV)
+DEFINE_PUSH_PRIMITIVE_EXECUTOR(sint64, int64_t, AFFIX_SvIV)
+DEFINE_PUSH_PRIMITIVE_EXECUTOR(uint64, uint64_t, AFFIX_SvUV)
+DEFINE_PUSH_PRIMITIVE_EXECUTOR(float, float, AFFIX_SvNV)
+DEFINE_PUSH_PRIMITIVE_EXECUTOR(double, double, AFFIX_SvNV)
+DEFINE_PUSH_PRIMITIVE_EXECUTOR(long_double, long double, AFFIX_SvNV)
 
 #if !defined(INFIX_COMPILER_MSVC)
 static void plan_step_push_sint128(pTHX_ Affix * affix,
@@ -538,7 +754,33 @@ static void plan_step_push_uint128(pTHX_ Affix * affix,
 //                      STATIC DATA & DEFINITIONS
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-static MGVTBL Affix_pin_vtbl = {Affix_get_pin, Affix_set_pin, Affix_len_pin, NULL, Affix_free_pin, NULL, NULL, NULL};
+static MGVTBL Affix_pin_vtbl = {
+    Affix_get_pin, Affix_set_pin, Affix_len_pin, NULL, Affix_free_pin, NULL, AFFIX_DUP(Affix_dup_pin), NULL};
+static MGVTBL Affix_callback_vtbl = {
+    NULL, NULL, NULL, NULL, Affix_free_callbacks, NULL, AFFIX_DUP(Affix_dup_callbacks), NULL};
+#ifdef USE_ITHREADS
+// Carried by the CV of every binding so that ithreads clones get their own per-thread state.
+static MGVTBL Affix_binding_vtbl = {NULL, NULL, NULL, NULL, NULL, NULL, Affix_dup_binding, NULL};
+// Carried by the scalar inside every Affix::Lib object.
+static MGVTBL Affix_lib_vtbl = {NULL, NULL, NULL, NULL, NULL, NULL, Affix_dup_lib, NULL};
+#endif
+
+/// @brief Attaches pin magic to `sv`.
+static MAGIC * _pin_magicext(pTHX_ SV * sv, Affix_Pin * pin) {
+    MAGIC * mg = sv_magicext(sv, NULL, PERL_MAGIC_ext, &Affix_pin_vtbl, (const char *)pin, 0);
+    mg->mg_flags |= MGf_DUP;
+    return mg;
+}
+/// @brief Marks a binding's CV so that cloning it into a new ithread runs Affix_dup_binding().
+static void _binding_set_dup(pTHX_ CV * cv) {
+#ifdef USE_ITHREADS
+    // The magic points back at its own CV, which is how the dup hook finds the clone.
+    MAGIC * mg = sv_magicext(MUTABLE_SV(cv), MUTABLE_SV(cv), PERL_MAGIC_ext, &Affix_binding_vtbl, NULL, 0);
+    mg->mg_flags |= MGf_DUP;
+#else
+    PERL_UNUSED_VAR(cv);
+#endif
+}
 
 static const Affix_Step_Executor primitive_executors[] = {
     [INFIX_PRIMITIVE_BOOL] = plan_step_push_bool,
@@ -574,21 +816,34 @@ static const Affix_Push_Handler primitive_push_handlers[] = {
     [INFIX_PRIMITIVE_LONG_DOUBLE] = push_handler_long_double,
 };
 
-// Signature helper
+/// @brief The signature text of a type string or Affix::Type object; anything else is stringified. Never NULL.
 static const char * _get_string_from_type_obj(pTHX_ SV * type_sv) {
+    // Types built by Affix.pm are plain strings; only objects need the class check.
+    if (!SvROK(type_sv))
+        return SvPV_nolen(type_sv);
     if (sv_isobject(type_sv) && sv_derived_from(type_sv, "Affix::Type")) {
-        if (SvROK(type_sv)) {
-            SV * rv = SvRV(type_sv);
-            if (SvTYPE(rv) == SVt_PVHV) {
-                HV * hv = (HV *)rv;
-                SV ** stringify_sv_ptr = hv_fetchs(hv, "stringify", 0);
-                if (stringify_sv_ptr && SvPOK(*stringify_sv_ptr))
-                    return SvPV_nolen(*stringify_sv_ptr);
-            }
+        SV * rv = SvRV(type_sv);
+        if (SvTYPE(rv) == SVt_PVHV) {
+            HV * hv = (HV *)rv;
+            SV ** stringify_sv_ptr = hv_fetchs(hv, "stringify", 0);
+            if (stringify_sv_ptr && SvPOK(*stringify_sv_ptr))
+                return SvPV_nolen(*stringify_sv_ptr);
         }
     }
     return SvPV_nolen(type_sv);
 }
+/// @brief A prototype of `count` scalars, e.g. `$$$`, with a trailing `@` if `rest`. Mortal.
+static const char * _scalar_prototype(pTHX_ size_t count, bool rest) {
+    SV * proto = sv_2mortal(newSV(count + 2));
+    char * p = SvPVX(proto);
+    memset(p, '$', count);
+    if (rest)
+        p[count++] = '@';
+    p[count] = '\0';
+    SvCUR_set(proto, count);
+    SvPOK_only(proto);
+    return SvPVX(proto);
+}
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //                      COMPLEX TYPE STEP EXECUTORS
@@ -709,25 +964,7 @@ static void plan_step_push_union(pTHX_ Affix * affix,
     SV * sv = perl_stack_frame[step->data.index];
     void * c_arg_ptr = (char *)args_buffer + step->data.c_arg_offset;
     c_args[step->data.index] = c_arg_ptr;
-    if (!SvROK(sv) || SvTYPE(SvRV(sv)) != SVt_PVHV)
-        croak("Expected a HASH reference for union marshalling");
-    HV * hv = (HV *)SvRV(sv);
-    if (hv_iterinit(hv) == 0)
-        return;
-    HE * he = hv_iternext(hv);
-    if (!he)
-        return;
-    const char * key = HeKEY(he);
-    STRLEN key_len = HeKLEN(he);
-    SV * value_sv = HeVAL(he);
-    for (size_t i = 0; i < type->meta.aggregate_info.num_members; ++i) {
-        const infix_struct_member * member = &type->meta.aggregate_info.members[i];
-        if (member->name && strlen(member->name) == key_len && memcmp(member->name, key, key_len) == 0) {
-            sv2ptr(aTHX_ affix, value_sv, c_arg_ptr, member->type);
-            return;
-        }
-    }
-    croak("Union member '%s' not found in type definition", key);
+    push_union(aTHX_ affix, type, sv, c_arg_ptr);
 }
 static void plan_step_push_array(pTHX_ Affix * affix,
                                  Affix_Plan_Step * step,
@@ -837,6 +1074,50 @@ static void plan_step_push_callback(pTHX_ Affix * affix,
     c_args[step->data.index] = c_arg_ptr;
     push_reverse_trampoline(aTHX_ affix, type, sv, c_arg_ptr);
 }
+static void plan_step_push_shared_callback(pTHX_ Affix * affix,
+                                           Affix_Plan_Step * step,
+                                           SV ** perl_stack_frame,
+                                           void * args_buffer,
+                                           void ** c_args,
+                                           void * ret_buffer) {
+    PERL_UNUSED_VAR(affix);
+    PERL_UNUSED_VAR(ret_buffer);
+    SV * sv = perl_stack_frame[step->data.index];
+    void * c_arg_ptr = (char *)args_buffer + step->data.c_arg_offset;
+    c_args[step->data.index] = c_arg_ptr;
+    // The coderef itself travels through the user-data argument; see plan_step_push_user_data.
+    if (SvROK(sv) && SvTYPE(SvRV(sv)) == SVt_PVCV)
+        *(void **)c_arg_ptr = step->data.shared_code;
+    else if (is_pin(aTHX_ sv))
+        *(void **)c_arg_ptr = _get_pin_from_sv(aTHX_ sv)->pointer;
+    else if (!SvOK(sv))
+        *(void **)c_arg_ptr = NULL;
+    else
+        croak("Argument for a callback must be a code reference or undef.");
+}
+static void plan_step_push_user_data(pTHX_ Affix * affix,
+                                     Affix_Plan_Step * step,
+                                     SV ** perl_stack_frame,
+                                     void * args_buffer,
+                                     void ** c_args,
+                                     void * ret_buffer) {
+    SV * code_sv = perl_stack_frame[step->data.peer_index];
+    if (!SvROK(code_sv) || SvTYPE(SvRV(code_sv)) != SVt_PVCV) {
+        // No coderef to carry (NULL or a native function pointer); pass the user's value as is.
+        plan_step_push_pointer(aTHX_ affix, step, perl_stack_frame, args_buffer, c_args, ret_buffer);
+        return;
+    }
+    void * c_arg_ptr = (char *)args_buffer + step->data.c_arg_offset;
+    c_args[step->data.index] = c_arg_ptr;
+    *(void **)c_arg_ptr = _get_callback_user_data(aTHX_ SvRV(code_sv), perl_stack_frame[step->data.index]);
+}
+/// @brief Calls a binding's C function with marshalled arguments, bound or unbound.
+static inline void _affix_call(Affix * affix, void * ret_buffer, void ** c_args) {
+    if (affix->unbound_cif)
+        affix->unbound_cif(affix->target, ret_buffer, c_args);
+    else
+        affix->cif(ret_buffer, c_args);
+}
 static void plan_step_call_c_function(pTHX_ Affix * affix,
                                       Affix_Plan_Step * step,
                                       SV ** perl_stack_frame,
@@ -846,7 +1127,7 @@ static void plan_step_call_c_function(pTHX_ Affix * affix,
     PERL_UNUSED_VAR(step);
     PERL_UNUSED_VAR(perl_stack_frame);
     PERL_UNUSED_VAR(args_buffer);
-    affix->cif(ret_buffer, c_args);
+    _affix_call(affix, ret_buffer, c_args);
 }
 static void plan_step_pull_return_value(pTHX_ Affix * affix,
                                         Affix_Plan_Step * step,
@@ -933,6 +1214,261 @@ Affix_Out_Param_Writer get_out_param_writer(const infix_type * pointee_type) {
     return writeback_primitive;
 }
 
+/// @brief Copies "out" parameters back into the Perl references they were passed as.
+static void _writeback_out_params(pTHX_ Affix * affix, SV ** perl_stack_frame, void ** c_args) {
+    size_t valid_out_indices[affix->num_out_params];
+    size_t num_valid_out_params = 0;
+
+    for (size_t i = 0; i < affix->num_out_params; ++i) {
+        const OutParamInfo * info = &affix->out_param_info[i];
+        SV * arg_sv = perl_stack_frame[info->perl_stack_index];
+
+        if (SvROK(arg_sv) && !is_pin(aTHX_ arg_sv))
+            valid_out_indices[num_valid_out_params++] = i;
+    }
+
+    for (size_t i = 0; i < num_valid_out_params; ++i) {
+        size_t info_idx = valid_out_indices[i];
+        const OutParamInfo * info = &affix->out_param_info[info_idx];
+
+        SV * rsv = SvRV(perl_stack_frame[info->perl_stack_index]);
+
+        if (SvTYPE(rsv) == SVt_PVAV)
+            continue;
+
+        // Use the local c_args pointer, which might be on the stack
+        info->writer(aTHX_ affix, info, rsv, c_args[info->perl_stack_index]);
+    }
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//                   MEMOIZATION FOR PURE BINDINGS
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// x87's 80-bit long double is stored padded to 12 or 16 bytes, and stores leave the padding as it was.
+#if LDBL_MANT_DIG == 64 && (defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64))
+#define AFFIX_LDBL_SIGNIFICANT 10
+#else
+#define AFFIX_LDBL_SIGNIFICANT sizeof(long double)
+#endif
+/**
+ * @brief Builds the cache key for the call in progress into `memo->key`.
+ *
+ * Scalars contribute their marshalled bytes straight from the args buffer, long doubles only
+ * the bytes that hold their value. Strings contribute a length prefix and their contents,
+ * since the pointer alone says nothing about the value.
+ */
+static void _memo_build_key(pTHX_ Affix * affix, SV ** perl_stack_frame, void * args_buffer) {
+    Affix_Memo * memo = affix->memo;
+    SvCUR_set(memo->key, 0);
+    for (size_t i = 0; i < affix->num_args; ++i) {
+        if (memo->string_args[i]) {
+            SV * sv = perl_stack_frame[i];
+            STRLEN len = 0;
+            const char * pv = SvOK(sv) ? SvPV(sv, len) : NULL;
+            STRLEN tag = pv ? len : (STRLEN)-1;  // undef (NULL) gets a length no string can have
+            sv_catpvn(memo->key, (const char *)&tag, sizeof(tag));
+            if (pv)
+                sv_catpvn(memo->key, pv, len);
+        }
+        else {
+            const infix_type * type = affix->plan[i].data.type;
+            bool long_double =
+                type->category == INFIX_TYPE_PRIMITIVE && type->meta.primitive_id == INFIX_PRIMITIVE_LONG_DOUBLE;
+            size_t size = long_double ? AFFIX_LDBL_SIGNIFICANT : infix_type_get_size(type);
+            sv_catpvn(memo->key, (const char *)args_buffer + affix->plan[i].data.c_arg_offset, size);
+        }
+    }
+}
+static void _memo_unlink(Affix_Memo * memo, Affix_Memo_Entry * entry) {
+    if (entry->prev)
+        entry->prev->next = entry->next;
+    else
+        memo->head = entry->next;
+    if (entry->next)
+        entry->next->prev = entry->prev;
+    else
+        memo->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+static void _memo_push_front(Affix_Memo * memo, Affix_Memo_Entry * entry) {
+    entry->prev = NULL;
+    entry->next = memo->head;
+    if (memo->head)
+        memo->head->prev = entry;
+    memo->head = entry;
+    if (!memo->tail)
+        memo->tail = entry;
+}
+/// @brief Finds the entry for the current key and marks it most recently used, or returns NULL.
+static Affix_Memo_Entry * _memo_lookup(pTHX_ Affix_Memo * memo) {
+    SV ** found = hv_fetch(memo->index, SvPVX(memo->key), SvCUR(memo->key), 0);
+    if (!found) {
+        memo->misses++;
+        return NULL;
+    }
+    Affix_Memo_Entry * entry = INT2PTR(Affix_Memo_Entry *, SvIV(*found));
+    if (entry != memo->head) {
+        _memo_unlink(memo, entry);
+        _memo_push_front(memo, entry);
+    }
+    memo->hits++;
+    return entry;
+}
+/// @brief On a hit, copies the cached result into `dest`.
+static bool _memo_fetch(pTHX_ Affix_Memo * memo, SV * dest) {
+    Affix_Memo_Entry * entry = _memo_lookup(aTHX_ memo);
+    if (!entry)
+        return false;
+    sv_setsv(dest, entry->value);
+    return true;
+}
+static void _memo_free_entry(pTHX_ Affix_Memo_Entry * entry) {
+    SvREFCNT_dec(entry->key);
+    SvREFCNT_dec(entry->value);
+    safefree(entry);
+}
+/// @brief Caches `value` under the current key, evicting the least recently used entry when full.
+static void _memo_store(pTHX_ Affix_Memo * memo, SV * value) {
+    if (memo->count >= memo->capacity) {
+        Affix_Memo_Entry * victim = memo->tail;
+        _memo_unlink(memo, victim);
+        (void)hv_delete(memo->index, SvPVX(victim->key), SvCUR(victim->key), G_DISCARD);
+        _memo_free_entry(aTHX_ victim);
+        memo->count--;
+    }
+    Affix_Memo_Entry * entry;
+    Newxz(entry, 1, Affix_Memo_Entry);
+    entry->key = newSVpvn(SvPVX(memo->key), SvCUR(memo->key));
+    entry->value = newSVsv(value);
+    (void)hv_store(memo->index, SvPVX(entry->key), SvCUR(entry->key), newSViv(PTR2IV(entry)), 0);
+    _memo_push_front(memo, entry);
+    memo->count++;
+}
+static void _memo_clear(pTHX_ Affix_Memo * memo) {
+    Affix_Memo_Entry * entry = memo->head;
+    while (entry) {
+        Affix_Memo_Entry * next = entry->next;
+        _memo_free_entry(aTHX_ entry);
+        entry = next;
+    }
+    memo->head = memo->tail = NULL;
+    memo->count = 0;
+    hv_clear(memo->index);
+}
+static Affix_Memo * _memo_new(pTHX_ size_t capacity) {
+    Affix_Memo * memo;
+    Newxz(memo, 1, Affix_Memo);
+    memo->index = newHV();
+    memo->key = newSV(64);
+    SvPOK_on(memo->key);
+    memo->capacity = capacity;
+    return memo;
+}
+static void _memo_destroy(pTHX_ Affix_Memo * memo) {
+    _memo_clear(aTHX_ memo);
+    SvREFCNT_dec(memo->index);
+    SvREFCNT_dec(memo->key);
+    safefree(memo->string_args);
+    safefree(memo);
+}
+/// @brief Rejects option names affix()/wrap() do not know; returns the error or NULL.
+static SV * _affix_check_options(pTHX_ HV * options) {
+    HE * he;
+    hv_iterinit(options);
+    while ((he = hv_iternext(options))) {
+        const char * key = HePV(he, PL_na);
+        if (strNE(key, "pure") && strNE(key, "cache_size") && strNE(key, "lazy"))
+            return sv_2mortal(newSVpvf("Unknown option '%s'", key));
+    }
+    return NULL;
+}
+/**
+ * @brief Checks binding options on their own, before there is a plan to check them against.
+ *
+ * Sets `capacity` to the result cache size of a pure binding, or 0 for any other.
+ * @return NULL if the options are valid, or a mortal SV describing what was wrong.
+ */
+static SV * _affix_options_preflight(pTHX_ HV * options, UV * capacity) {
+    *capacity = 0;
+    SV * error = _affix_check_options(aTHX_ options);
+    if (error)
+        return error;
+    SV ** pure = hv_fetchs(options, "pure", 0);
+    if (!pure || !SvTRUE(*pure))
+        return NULL;
+
+    SV ** cache_size = hv_fetchs(options, "cache_size", 0);
+    UV size = cache_size && SvOK(*cache_size) ? SvUV(*cache_size) : 256;
+    if (size == 0)
+        return sv_2mortal(newSVpvs("cache_size must be at least 1"));
+    *capacity = size;
+    return NULL;
+}
+/// @brief Rejects argument `index` of a pure binding unless it is a number or a string; returns the error or NULL.
+static SV * _pure_arg_error(pTHX_ const infix_type * type, size_t index) {
+    if (type->category == INFIX_TYPE_PRIMITIVE || type->category == INFIX_TYPE_ENUM)
+        return NULL;
+    if (type->category == INFIX_TYPE_POINTER) {
+        const infix_type * pointee = type->meta.pointer_info.pointee_type;
+        if (pointee->category == INFIX_TYPE_PRIMITIVE && (pointee->meta.primitive_id == INFIX_PRIMITIVE_SINT8 ||
+                                                          pointee->meta.primitive_id == INFIX_PRIMITIVE_UINT8))
+            return NULL;
+    }
+    return sv_2mortal(
+        newSVpvf("A pure function may only take numbers and strings, but argument %d is not one", (int)index + 1));
+}
+/**
+ * @brief Checks binding options against a plan without applying them.
+ *
+ * Sets `capacity` to the result cache size of a pure binding, or 0 for any other.
+ * @return NULL if the options can be applied, or a mortal SV describing what was wrong.
+ */
+static SV * _affix_options_error(pTHX_ const Affix * affix, HV * options, UV * capacity) {
+    SV * error = _affix_options_preflight(aTHX_ options, capacity);
+    if (error || *capacity == 0)
+        return error;
+    for (size_t i = 0; i < affix->num_args; ++i) {
+        if ((error = _pure_arg_error(aTHX_ affix->plan[i].data.type, i))) {
+            *capacity = 0;
+            return error;
+        }
+    }
+    return NULL;
+}
+/**
+ * @brief Applies the options hash passed as the last argument of affix()/wrap().
+ *
+ * @return NULL on success, or a mortal SV describing what was wrong.
+ */
+static SV * _affix_apply_options(pTHX_ Affix * affix, HV * options) {
+    UV capacity;
+    SV * error = _affix_options_error(aTHX_ affix, options, &capacity);
+    if (error || capacity == 0)
+        return error;
+    // Every pointer a pure binding accepts is a string.
+    bool * string_args;
+    Newxz(string_args, affix->num_args + 1, bool);
+    for (size_t i = 0; i < affix->num_args; ++i)
+        string_args[i] = affix->plan[i].data.type->category == INFIX_TYPE_POINTER;
+    affix->memo = _memo_new(aTHX_ capacity);
+    affix->memo->string_args = string_args;
+    return NULL;
+}
+/// @brief The plan behind a binding returned by affix()/wrap(), or NULL for anything else.
+///
+/// A lazy binding is resolved here, as if it had been called.
+static Affix * _affix_from_binding(pTHX_ SV * binding) {
+    if (!(sv_isobject(binding) && sv_derived_from(binding, "Affix")) || SvTYPE(SvRV(binding)) != SVt_PVCV)
+        return NULL;
+    CV * cv = (CV *)SvRV(binding);
+    if (CvXSUB(cv) == Affix_trigger_lazy)
+        return _lazy_resolve(aTHX_ cv);
+    if (CvXSUB(cv) != Affix_trigger)
+        return NULL;
+    return (Affix *)CvXSUBANY(cv).any_ptr;
+}
+
 // Classic trigger system
 #if defined(INFIX_COMPILER_GCC) || defined(INFIX_COMPILER_CLANG)
 #define USE_COMPUTED_GOTO 1
@@ -942,7 +1478,8 @@ Affix_Out_Param_Writer get_out_param_writer(const infix_type * pointee_type) {
         &&CASE_OP_PUSH_UINT16,   &&CASE_OP_PUSH_SINT32, &&CASE_OP_PUSH_UINT32,  &&CASE_OP_PUSH_SINT64,  \
         &&CASE_OP_PUSH_UINT64,   &&CASE_OP_PUSH_FLOAT,  &&CASE_OP_PUSH_DOUBLE,  &&CASE_OP_PUSH_POINTER, \
         &&CASE_OP_PUSH_SV,       &&CASE_OP_PUSH_STRUCT, &&CASE_OP_PUSH_UNION,   &&CASE_OP_PUSH_ARRAY,   \
-        &&CASE_OP_PUSH_CALLBACK, &&CASE_OP_PUSH_ENUM,   &&CASE_OP_PUSH_COMPLEX, &&CASE_OP_PUSH_VECTOR};
+        &&CASE_OP_PUSH_CALLBACK, &&CASE_OP_PUSH_ENUM,   &&CASE_OP_PUSH_COMPLEX, &&CASE_OP_PUSH_VECTOR,  \
+        &&CASE_OP_PUSH_USER_DATA};
 #define DISPATCH()                               \
     do {                                         \
         step++;                                  \
@@ -964,6 +1501,8 @@ void Affix_trigger(pTHX_ CV * cv) {
     dAXMARK;
     dXSTARG;
     Affix * affix = (Affix *)CvXSUBANY(cv).any_ptr;
+    // Read before marshalling: a nested call_ptr() through the same plan may retarget it.
+    void * target = affix->target;
 
     if (UNLIKELY((SP - MARK) != affix->num_args))
         croak("Wrong number of arguments. Expected %d, got %d", (int)affix->num_args, (int)(SP - MARK));
@@ -1017,7 +1556,7 @@ DISPATCH_LOOP:
     TARGET(OP_PUSH_SINT32) {
         SV * sv = perl_stack_frame[step->data.index];
         void * ptr = (char *)args_buffer + step->data.c_arg_offset;
-        *(int32_t *)ptr = (int32_t)SvIV(sv);
+        *(int32_t *)ptr = (int32_t)_affix_sv_iv(aTHX_ sv);
         c_args[step->data.index] = ptr;
         DISPATCH();
     }
@@ -1025,7 +1564,7 @@ DISPATCH_LOOP:
     TARGET(OP_PUSH_UINT32) {
         SV * sv = perl_stack_frame[step->data.index];
         void * ptr = (char *)args_buffer + step->data.c_arg_offset;
-        *(uint32_t *)ptr = (uint32_t)SvUV(sv);
+        *(uint32_t *)ptr = (uint32_t)_affix_sv_uv(aTHX_ sv);
         c_args[step->data.index] = ptr;
         DISPATCH();
     }
@@ -1033,7 +1572,7 @@ DISPATCH_LOOP:
     TARGET(OP_PUSH_SINT64) {
         SV * sv = perl_stack_frame[step->data.index];
         void * ptr = (char *)args_buffer + step->data.c_arg_offset;
-        *(int64_t *)ptr = (int64_t)SvIV(sv);
+        *(int64_t *)ptr = (int64_t)_affix_sv_iv(aTHX_ sv);
         c_args[step->data.index] = ptr;
         DISPATCH();
     }
@@ -1041,15 +1580,7 @@ DISPATCH_LOOP:
     TARGET(OP_PUSH_DOUBLE) {
         SV * sv = perl_stack_frame[step->data.index];
         void * ptr = (char *)args_buffer + step->data.c_arg_offset;
-        // Inline the optimized double check logic here for speed
-        U32 flags = SvFLAGS(sv);
-        if (LIKELY(flags & SVf_NOK))
-            *(double *)ptr = SvNVX(sv);
-        else if (flags & SVf_IOK)
-            *(double *)ptr = (double)((flags & SVf_IVisUV) ? SvUVX(sv) : SvIVX(sv));
-        else
-            *(double *)ptr = (double)SvNV(sv);
-
+        *(double *)ptr = (double)_affix_sv_nv(aTHX_ sv);
         c_args[step->data.index] = ptr;
         DISPATCH();
     }
@@ -1080,6 +1611,7 @@ DISPATCH_LOOP:
     TARGET(OP_PUSH_ENUM)
     TARGET(OP_PUSH_COMPLEX)
     TARGET(OP_PUSH_VECTOR)
+    TARGET(OP_PUSH_USER_DATA)
     TARGET(OP_PUSH_SV) {
         // For complex types, falling back to the function pointer is acceptable
         // as the marshalling overhead dominates the dispatch overhead.
@@ -1105,43 +1637,35 @@ DISPATCH_LOOP:
 
 DONE:
 
+    // A pure binding answers repeated arguments from its cache.
+    if (UNLIKELY(affix->memo != NULL)) {
+        _memo_build_key(aTHX_ affix, perl_stack_frame, args_buffer);
+        if (_memo_fetch(aTHX_ affix->memo, TARG)) {
+            ST(0) = TARG;
+            PL_stack_sp = PL_stack_base + ax;
+            return;
+        }
+    }
+
     // Call...
-    affix->cif(ret_buffer, c_args);
+    if (affix->unbound_cif)
+        affix->unbound_cif(target, ret_buffer, c_args);
+    else
+        affix->cif(ret_buffer, c_args);
 
 // Return...
 if (affix->ret_pull_handler)
     affix->ret_pull_handler(aTHX_ affix, TARG, affix->ret_type, ret_buffer);
+if (UNLIKELY(affix->memo != NULL))
+    _memo_store(aTHX_ affix->memo, TARG);
 
 // Deal with XS's OUT params
-if (affix->num_out_params > 0) {
-    size_t valid_out_indices[affix->num_out_params];
-    size_t num_valid_out_params = 0;
-
-    for (size_t i = 0; i < affix->num_out_params; ++i) {
-        const OutParamInfo * info = &affix->out_param_info[i];
-        SV * arg_sv = perl_stack_frame[info->perl_stack_index];
+if (affix->num_out_params > 0)
+    _writeback_out_params(aTHX_ affix, perl_stack_frame, c_args);
 
-        if (SvROK(arg_sv) && !is_pin(aTHX_ arg_sv))
-            valid_out_indices[num_valid_out_params++] = i;
-    }
-
-    for (size_t i = 0; i < num_valid_out_params; ++i) {
-        size_t info_idx = valid_out_indices[i];
-        const OutParamInfo * info = &affix->out_param_info[info_idx];
-
-        SV * rsv = SvRV(perl_stack_frame[info->perl_stack_index]);
-
-        if (SvTYPE(rsv) == SVt_PVAV)
-            continue;
-
-        // Use the local c_args pointer, which might be on the stack
-        info->writer(aTHX_ affix, info, rsv, c_args[info->perl_stack_index]);
-    }
-}
-
-ST(0) = TARG;
-PL_stack_sp = PL_stack_base + ax;
-}
+ST(0) = TARG;
+PL_stack_sp = PL_stack_base + ax;
+}
 
 void xxxAffix_trigger(pTHX_ CV * cv) {
     dSP;
@@ -1231,25 +1755,332 @@ void xxxAffix_trigger(pTHX_ CV * cv) {
     return;
 }
 
-static infix_library_t * _get_lib_from_registry(pTHX_ const char * path) {
+/// @brief Takes a reference on the registry entry for `path` (NULL for the program), opening it if needed.
+static LibRegistryEntry * _lib_registry_acquire(pTHX_ const char * path) {
     dMY_CXT;
     const char * lookup_path = (path == NULL) ? "" : path;
     SV ** entry_sv_ptr = hv_fetch(MY_CXT.lib_registry, lookup_path, strlen(lookup_path), 0);
     if (entry_sv_ptr) {
         LibRegistryEntry * entry = INT2PTR(LibRegistryEntry *, SvIV(*entry_sv_ptr));
         entry->ref_count++;
-        return entry->lib;
+        return entry;
     }
     infix_library_t * lib = infix_library_open(path);
-    if (lib) {
-        LibRegistryEntry * new_entry;
-        Newxz(new_entry, 1, LibRegistryEntry);
-        new_entry->lib = lib;
-        new_entry->ref_count = 1;
-        hv_store(MY_CXT.lib_registry, lookup_path, strlen(lookup_path), newSViv(PTR2IV(new_entry)), 0);
-        return lib;
+    if (lib == NULL)
+        return NULL;
+    LibRegistryEntry * new_entry;
+    Newxz(new_entry, 1, LibRegistryEntry);
+    new_entry->lib = lib;
+    new_entry->ref_count = 1;
+    new_entry->path = savepv(lookup_path);
+    hv_store(MY_CXT.lib_registry, lookup_path, strlen(lookup_path), newSViv(PTR2IV(new_entry)), 0);
+    return new_entry;
+}
+
+/**
+ * @brief Builds the call plan for a signature.
+ *
+ * With a NULL `symbol`, the plan is built on an unbound trampoline and the caller sets
+ * `affix->target` before each call.
+ */
+static Affix * _new_affix(pTHX_ const char * signature, void * symbol) {
+    dMY_CXT;
+    Affix * affix;
+    Newxz(affix, 1, Affix);
+    affix->return_sv = newSV(0);  // Kept for safety, though hot path uses TARG
+
+    // Without a symbol the trampoline is unbound: the target is supplied per call in affix->target.
+    infix_status status = symbol ? infix_forward_create(&affix->infix, signature, symbol, MY_CXT.registry)
+                                 : infix_forward_create_unbound(&affix->infix, signature, MY_CXT.registry);
+
+    if (status != INFIX_SUCCESS) {
+        SvREFCNT_dec(affix->return_sv);
+        safefree(affix);
+        croak("Failed to parse signature or create trampoline: %s", infix_get_last_error().message);
     }
-    return NULL;
+
+    if (symbol)
+        affix->cif = infix_forward_get_code(affix->infix);
+    else
+        affix->unbound_cif = infix_forward_get_unbound_code(affix->infix);
+    affix->num_args = infix_forward_get_num_args(affix->infix);
+    affix->ret_type = infix_forward_get_return_type(affix->infix);
+
+    // OPTIMIZATION: Pre-resolve the return handler here to avoid switch/lookup in hot path
+    affix->ret_pull_handler = get_pull_handler(affix->ret_type);
+    if (affix->ret_pull_handler == NULL) {
+        infix_forward_destroy(affix->infix);
+        SvREFCNT_dec(affix->return_sv);
+        safefree(affix);
+        croak("Unsupported return type in signature");
+    }
+
+    if (affix->num_args > 0)
+        Newx(affix->c_args, affix->num_args, void *);
+    else
+        affix->c_args = NULL;
+
+    affix->args_arena = infix_arena_create(4096);
+    affix->ret_arena = infix_arena_create(1024);
+    if (!affix->args_arena || !affix->ret_arena)
+        croak("Failed to create memory arenas for FFI call");
+
+    // OPTIMIZATION: Plan length is exactly num_args.
+    // We do not create steps for "call" or "return".
+    affix->plan_length = affix->num_args;
+    if (affix->plan_length > 0)
+        Newxz(affix->plan, affix->plan_length, Affix_Plan_Step);
+    else
+        affix->plan = NULL;
+
+    size_t current_offset = 0;
+    for (size_t i = 0; i < affix->num_args; ++i) {
+        const infix_type * type = infix_forward_get_arg_type(affix->infix, i);
+        size_t alignment = (type->category == INFIX_TYPE_ARRAY) ? type->alignment : infix_type_get_alignment(type);
+        if (alignment == 0)
+            alignment = 1;
+
+        current_offset = (current_offset + alignment - 1) & ~(alignment - 1);
+        affix->plan[i].data.c_arg_offset = current_offset;
+
+        size_t size = (type->category == INFIX_TYPE_ARRAY) ? type->size : infix_type_get_size(type);
+        current_offset += size;
+    }
+    affix->total_args_size = current_offset;
+
+    // Setup Execution Plan
+    size_t out_param_count = 0;
+    OutParamInfo * temp_out_info = safemalloc(sizeof(OutParamInfo) * (affix->num_args > 0 ? affix->num_args : 1));
+
+    for (size_t i = 0; i < affix->num_args; ++i) {
+        const infix_type * type = infix_forward_get_arg_type(affix->infix, i);
+        affix->plan[i].executor = get_plan_step_executor(type);
+        affix->plan[i].opcode = get_opcode_for_type(type);
+
+        if (affix->plan[i].executor == NULL) {
+            safefree(temp_out_info);
+            infix_forward_destroy(affix->infix);
+            SvREFCNT_dec(affix->return_sv);
+            infix_arena_destroy(affix->args_arena);
+            infix_arena_destroy(affix->ret_arena);
+            if (affix->plan)
+                safefree(affix->plan);
+            safefree(affix);
+            croak("Unsupported argument type in signature at index %zu", i);
+        }
+
+        affix->plan[i].data.type = type;
+        affix->plan[i].data.index = i;
+
+        if (type->category == INFIX_TYPE_POINTER) {
+            const infix_type * pointee_type = type->meta.pointer_info.pointee_type;
+            if (pointee_type->category != INFIX_TYPE_REVERSE_TRAMPOLINE && pointee_type->category != INFIX_TYPE_VOID) {
+                temp_out_info[out_param_count].perl_stack_index = i;
+                temp_out_info[out_param_count].pointee_type = pointee_type;
+                temp_out_info[out_param_count].writer = get_out_param_writer(pointee_type);
+                out_param_count++;
+            }
+        }
+    }
+
+    affix->num_out_params = out_param_count;
+    if (out_param_count > 0) {
+        affix->out_param_info = safemalloc(sizeof(OutParamInfo) * out_param_count);
+        memcpy(affix->out_param_info, temp_out_info, sizeof(OutParamInfo) * out_param_count);
+    }
+    else {
+        affix->out_param_info = NULL;
+    }
+    safefree(temp_out_info);
+
+    _plan_shared_callbacks(aTHX_ affix);
+
+    Newxz(affix->core, 1, Affix_Core);
+    affix->core->ref_count = 1;
+    affix->core->infix = affix->infix;
+    affix->core->plan = affix->plan;
+    affix->core->plan_length = affix->plan_length;
+    affix->core->out_param_info = affix->out_param_info;
+    return affix;
+}
+
+/**
+ * @brief A binding on another's core: the trampoline, plan and types are shared and refcounted.
+ *
+ * Arenas, the argument vector, the return SV and any result cache belong to one binding
+ * and are made afresh.
+ */
+static Affix * _derive_affix(pTHX_ const Affix * parent) {
+    Affix * affix;
+    Newx(affix, 1, Affix);
+    StructCopy(parent, affix, Affix);
+    OP_REFCNT_LOCK;
+    affix->core->ref_count++;
+    OP_REFCNT_UNLOCK;
+    affix->return_sv = newSV(0);
+    affix->args_arena = infix_arena_create(4096);
+    affix->ret_arena = infix_arena_create(1024);
+    if (!affix->args_arena || !affix->ret_arena)
+        croak("Failed to create memory arenas for FFI call");
+    affix->c_args = NULL;
+    if (affix->num_args > 0)
+        Newx(affix->c_args, affix->num_args, void *);
+    affix->target = NULL;
+    affix->lib_entry = NULL;
+    affix->memo = NULL;
+    return affix;
+}
+
+/**
+ * @brief `signature` with insignificant whitespace removed.
+ *
+ * Spellings of one signature, like `(int32, int32)->int32` and `(int32,int32) -> int32`,
+ * then share a cache entry. A run of whitespace only survives, as one space, between two
+ * word characters.
+ */
+static SV * _signature_key(pTHX_ const char * signature) {
+    STRLEN len = strlen(signature);
+    SV * key = sv_2mortal(newSV(len + 1));
+    char * out = SvPVX(key);
+    char * start = out;
+    bool space = false;
+    for (const char * p = signature; *p; ++p) {
+        if (isSPACE(*p)) {
+            space = true;
+            continue;
+        }
+        if (space && out > start && isWORDCHAR(out[-1]) && isWORDCHAR(*p))
+            *out++ = ' ';
+        space = false;
+        *out++ = *p;
+    }
+    *out = '\0';
+    SvCUR_set(key, out - start);
+    SvPOK_only(key);
+    return key;
+}
+
+/**
+ * @brief The per-thread plan on an unbound trampoline for `signature`, built on first use.
+ *
+ * The caller gets a mortal reference, so the plan outlives a typedef redefinition that
+ * drops it from the cache while it is still running.
+ */
+static CV * _unbound_trigger(pTHX_ const char * signature) {
+    dMY_CXT;
+    SV * key = _signature_key(aTHX_ signature);
+    signature = SvPVX(key);
+    STRLEN sig_len = SvCUR(key);
+    SV ** cached = hv_fetch(MY_CXT.signature_cache, signature, sig_len, 0);
+    if (cached)
+        return (CV *)sv_2mortal(SvREFCNT_inc_simple_NN(SvRV(*cached)));
+    Affix * affix = _new_affix(aTHX_ signature, NULL);
+    CV * trigger = newXSproto_portable(NULL, Affix_trigger, __FILE__, NULL);
+    CvXSUBANY(trigger).any_ptr = (void *)affix;
+    SV * obj = newRV_noinc(MUTABLE_SV(trigger));
+    sv_bless(obj, gv_stashpv("Affix", GV_ADD));
+    hv_store(MY_CXT.signature_cache, signature, sig_len, obj, 0);
+    return (CV *)sv_2mortal(SvREFCNT_inc_simple_NN((SV *)trigger));
+}
+
+/**
+ * @brief Builds a binding of `symbol` on the one unbound trampoline kept for its signature.
+ *
+ * Binding a large API then costs one JIT compile and one executable mapping per distinct
+ * signature instead of one per function, and the trampolines stay packed on a few pages.
+ */
+static Affix * _new_bound_affix(pTHX_ const char * signature, void * symbol) {
+    CV * trigger = _unbound_trigger(aTHX_ signature);
+    Affix * affix = _derive_affix(aTHX_(Affix *) CvXSUBANY(trigger).any_ptr);
+    affix->target = symbol;
+    return affix;
+}
+
+/// @brief The signature text for `[\@args => $ret]`, in a mortal buffer.
+static const char * _signature_from_list(pTHX_ SV * args_sv, SV * ret_sv) {
+    if (!SvROK(args_sv) || SvTYPE(SvRV(args_sv)) != SVt_PVAV)
+        croak("Usage: affix(..., \\@args, $ret_type) - 3rd argument must be an array reference of types");
+    if (sv_isobject(ret_sv) && !sv_derived_from(ret_sv, "Affix::Type"))
+        croak("Usage: affix(..., \\@args, $ret_type) - 4th argument must be an Affix::Type object");
+
+    // Built in an SV, so neither long struct types nor many arguments can overflow it.
+    SV * signature_sv = sv_2mortal(newSVpvs("("));
+    AV * args_av = (AV *)SvRV(args_sv);
+    SSize_t num_args = av_len(args_av) + 1;
+    bool prev_varargs = false;
+
+    for (SSize_t i = 0; i < num_args; ++i) {
+        SV ** type_sv_ptr = av_fetch(args_av, i, 0);
+        if (!type_sv_ptr)
+            continue;
+        const char * arg_sig = _get_string_from_type_obj(aTHX_ * type_sv_ptr);
+        // VarArgs (';') separates the fixed and variadic parts rather than being an argument itself.
+        bool is_varargs = strEQ(arg_sig, ";");
+        if (i > 0 && !is_varargs && !prev_varargs)
+            sv_catpvs(signature_sv, ",");
+        sv_catpv(signature_sv, arg_sig);
+        prev_varargs = is_varargs;
+    }
+    sv_catpvs(signature_sv, ") -> ");
+
+    sv_catpv(signature_sv, _get_string_from_type_obj(aTHX_ ret_sv));
+    return SvPVX(signature_sv);
+}
+
+/// @brief Takes another reference on a library entry, which may be NULL.
+static LibRegistryEntry * _lib_registry_retain(LibRegistryEntry * entry) {
+    if (entry != NULL)
+        entry->ref_count++;
+    return entry;
+}
+
+/**
+ * @brief Builds and blesses the binding for `signature`, installed as `name` unless that is NULL.
+ *
+ * The binding takes its own reference on `lib_entry` once it is made, so the caller's reference
+ * is untouched whether this returns or croaks. `symbol` may be NULL for a lazy binding.
+ */
+static CV * _new_binding(pTHX_ const char * signature, void * symbol, const char * symbol_name,
+                         LibRegistryEntry * lib_entry, HV * options, bool lazy, const char * name) {
+    CV * cv_new;
+    // A variadic part left empty is filled in per call from the arguments.
+    STRLEN semi, close;
+    if (_variadic_split(signature, &semi, &close)) {
+        if (options)
+            croak("Binding options are not supported for variadic functions");
+        cv_new = _new_variadic_binding(aTHX_ signature, semi, close, symbol, name);
+        Affix_Variadic * variadic = (Affix_Variadic *)CvXSUBANY(cv_new).any_ptr;
+        variadic->lib_entry = _lib_registry_retain(lib_entry);
+        _binding_set_dup(aTHX_ cv_new);
+        sv_bless(sv_2mortal(newRV_inc(MUTABLE_SV(cv_new))), gv_stashpvs("Affix::Variadic", GV_ADD));
+        return cv_new;
+    }
+
+    if (lazy) {
+        cv_new = _new_lazy_binding(aTHX_ signature, symbol_name, symbol, options, name);
+        ((Affix_Lazy *)CvXSUBANY(cv_new).any_ptr)->lib_entry = _lib_registry_retain(lib_entry);
+    }
+    else {
+        Affix * affix = _new_bound_affix(aTHX_ signature, symbol);
+        if (options) {
+            SV * error = _affix_apply_options(aTHX_ affix, options);
+            if (error) {
+                _destroy_affix(aTHX_ affix);
+                croak_sv(error);
+            }
+        }
+        cv_new =
+            newXSproto_portable(name, Affix_trigger, __FILE__, _scalar_prototype(aTHX_ affix->num_args, false));
+        if (UNLIKELY(cv_new == NULL)) {
+            _destroy_affix(aTHX_ affix);
+            croak("Failed to install new XSUB");
+        }
+        CvXSUBANY(cv_new).any_ptr = (void *)affix;
+        affix->lib_entry = _lib_registry_retain(lib_entry);
+    }
+    _binding_set_dup(aTHX_ cv_new);
+    sv_bless(sv_2mortal(newRV_inc(MUTABLE_SV(cv_new))), gv_stashpvs("Affix", GV_ADD));
+    return cv_new;
 }
 
 XS_INTERNAL(Affix_affix) {
@@ -1260,19 +2091,26 @@ XS_INTERNAL(Affix_affix) {
     // ---------------------------------------------------------
     // 1. Argument Parsing and Symbol Resolution (Shared)
     // ---------------------------------------------------------
-    if (ix == 2 || ix == 4) {
+    // A trailing plain hash reference holds binding options.
+    HV * options = NULL;
+    if (items > 3 && SvROK(ST(items - 1)) && SvTYPE(SvRV(ST(items - 1))) == SVt_PVHV && !sv_isobject(ST(items - 1))) {
+        if (ix == 2 || ix == 3)
+            croak("Binding options are not supported for direct bindings");
+        options = (HV *)SvRV(ST(items - 1));
+        items--;
+    }
+    if (ix == 2 || ix == 3) {
         if (items != 3)
             croak_xs_usage(cv, "Affix::affix_bundle($target, $name, $signature)");
     }
     else {
         if (items != 3 && items != 4)
-            croak_xs_usage(cv, "Affix::affix($target, $name_spec, $signature, [$return])");
+            croak_xs_usage(cv, "Affix::affix($target, $name_spec, $signature, [$return], [\\%options])");
     }
 
     void * symbol = NULL;
     char * rename = NULL;
-    infix_library_t * lib_handle_for_symbol = NULL;
-    bool created_implicit_handle = false;
+    LibRegistryEntry * lib_entry = NULL;
     SV * target_sv = ST(0);
     SV * name_sv = ST(1);
     const char * symbol_name_str = NULL;
@@ -1292,46 +2130,36 @@ XS_INTERNAL(Affix_affix) {
     }
     rename = (char *)rename_str;
 
+    // Every binding holds its own reference on the library, so the handle outlives an
+    // Affix::Lib object that goes out of scope first.
     if (sv_isobject(target_sv) && sv_derived_from(target_sv, "Affix::Lib")) {
-        IV tmp = SvIV((SV *)SvRV(target_sv));
-        lib_handle_for_symbol = INT2PTR(infix_library_t *, tmp);
-        created_implicit_handle = false;
+        lib_entry = _lib_entry_from_sv(aTHX_ target_sv);
+        if (lib_entry)
+            lib_entry->ref_count++;
     }
     else if (_get_pin_from_sv(aTHX_ target_sv)) {
         symbol = _get_pin_from_sv(aTHX_ target_sv)->pointer;
     }
     else {
         const char * path = SvOK(target_sv) ? SvPV_nolen(target_sv) : NULL;
-        lib_handle_for_symbol = _get_lib_from_registry(aTHX_ path);
-        if (lib_handle_for_symbol)
-            created_implicit_handle = true;
-    }
-
-    if (lib_handle_for_symbol && !symbol)
-        symbol = infix_library_get_symbol(lib_handle_for_symbol, symbol_name_str);
-
-    if (symbol == NULL) {
-        if (created_implicit_handle) {
-            // Cleanup implicit handle if symbol not found
-            const char * lookup_path = SvOK(target_sv) ? SvPV_nolen(target_sv) : "";
-            SV ** entry_sv_ptr = hv_fetch(MY_CXT.lib_registry, lookup_path, strlen(lookup_path), 0);
-            if (entry_sv_ptr) {
-                LibRegistryEntry * entry = INT2PTR(LibRegistryEntry *, SvIV(*entry_sv_ptr));
-                entry->ref_count--;
-                if (entry->ref_count == 0) {
-                    infix_library_close(entry->lib);
-                    safefree(entry);
-                    hv_delete_ent(MY_CXT.lib_registry, newSVpvn(lookup_path, strlen(lookup_path)), G_DISCARD, 0);
-                }
-            }
-        }
+        lib_entry = _lib_registry_acquire(aTHX_ path);
+    }
+
+    // A lazy binding looks its symbol up on the first call instead.
+    SV ** lazy_sv = options ? hv_fetchs(options, "lazy", 0) : NULL;
+    bool lazy = lazy_sv && SvTRUE(*lazy_sv);
+    if (lib_entry && !symbol && !lazy)
+        symbol = infix_library_get_symbol(lib_entry->lib, symbol_name_str);
+
+    if (symbol == NULL && !(lazy && lib_entry)) {
+        _lib_registry_release(aTHX_ lib_entry);
         XSRETURN_UNDEF;
     }
 
     // ---------------------------------------------------------
     // 2. Path A: Affix Bundle (High-Performance JIT Backend)
     // ---------------------------------------------------------
-    if (ix == 2) {
+    if (ix == 2 || ix == 3) {
         Affix_Backend * backend;
         Newxz(backend, 1, Affix_Backend);
 
@@ -1346,6 +2174,7 @@ XS_INTERNAL(Affix_affix) {
 
         if (status != INFIX_SUCCESS) {
             safefree(backend);
+            _lib_registry_release(aTHX_ lib_entry);
             croak("Failed to parse signature for affix_bundle: %s", infix_get_last_error().message);
         }
 
@@ -1362,33 +2191,42 @@ XS_INTERNAL(Affix_affix) {
 
         if (status != INFIX_SUCCESS) {
             safefree(backend);
+            _lib_registry_release(aTHX_ lib_entry);
             croak("Failed to create direct trampoline: %s", infix_get_last_error().message);
         }
 
         backend->cif = infix_forward_get_direct_code(backend->infix);
         backend->num_args = num_args;
+        Newx(backend->arg_types, num_args + 1, const infix_type *);
+        for (size_t i = 0; i < num_args; ++i) {
+            backend->arg_types[i] = infix_forward_get_arg_type(backend->infix, i);
+            if (backend->arg_types[i]->category == INFIX_TYPE_POINTER)
+                backend->has_pointer_args = true;
+        }
         backend->ret_type = infix_forward_get_return_type(backend->infix);
+        backend->ret_kind = _direct_ret_kind(backend->ret_type);
         backend->pull_handler = get_pull_handler(backend->ret_type);
 
         if (!backend->pull_handler) {
             infix_forward_destroy(backend->infix);
+            safefree(backend->arg_types);
             safefree(backend);
+            _lib_registry_release(aTHX_ lib_entry);
             croak("Unsupported return type for affix_bundle");
         }
 
-        // Explicitly set lib_handle so we can clean it up later
-        backend->lib_handle = created_implicit_handle ? lib_handle_for_symbol : NULL;
-
-        char prototype_buf[256] = {0};
-        for (size_t i = 0; i < backend->num_args; ++i)
-            strcat(prototype_buf, "$");
+        Newxz(backend->core, 1, Affix_Core);
+        backend->core->ref_count = 1;
+        backend->core->infix = backend->infix;
+        backend->lib_entry = lib_entry;
 
-        //    CV * cv_new = newXSproto_portable(ix == 0 ? rename : NULL, Affix_trigger, __FILE__, prototype_buf);
-        CV * cv_new =
-            newXSproto_portable((ix == 0 || ix == 2) ? rename : NULL, Affix_trigger_backend, __FILE__, prototype_buf);
-        //~ CV * cv_new = newXSproto_portable(rename_str, Affix_trigger_backend, __FILE__, prototype_buf);
+        CV * cv_new = newXSproto_portable((ix == 0 || ix == 2) ? rename : NULL,
+                                          Affix_trigger_backend,
+                                          __FILE__,
+                                          _scalar_prototype(aTHX_ backend->num_args, false));
 
         CvXSUBANY(cv_new).any_ptr = (void *)backend;
+        _binding_set_dup(aTHX_ cv_new);
 
         SV * obj = newRV_inc(MUTABLE_SV(cv_new));
         sv_bless(obj, gv_stashpv("Affix::Bundled", GV_ADD));
@@ -1399,243 +2237,736 @@ XS_INTERNAL(Affix_affix) {
     // ---------------------------------------------------------
     // 3. Path B: Standard Affix (Optimized Frontend)
     // ---------------------------------------------------------
+    // The binding takes its own reference; ours goes when we are done, even if building it croaks.
+    ENTER;
+    SAVEDESTRUCTOR_X(_lib_registry_release_any, lib_entry);
     const char * signature = NULL;
-    char signature_buf[1024] = {0};
-
-    if (items == 4) {
-        SV * args_sv = ST(2);
-        SV * ret_sv = ST(3);
 
-        if (!SvROK(args_sv) || SvTYPE(SvRV(args_sv)) != SVt_PVAV)
-            croak("Usage: affix(..., \\@args, $ret_type) - 3rd argument must be an array reference of types");
-        if (sv_isobject(ret_sv) && !sv_derived_from(ret_sv, "Affix::Type"))
-            croak("Usage: affix(..., \\@args, $ret_type) - 4th argument must be an Affix::Type object");
+    if (items == 4)
+        signature = _signature_from_list(aTHX_ ST(2), ST(3));
+    else
+        signature = _get_string_from_type_obj(aTHX_ ST(2));
 
-        strcat(signature_buf, "(");
-        AV * args_av = (AV *)SvRV(args_sv);
-        SSize_t num_args = av_len(args_av) + 1;
+    CV * cv_new =
+        _new_binding(aTHX_ signature, symbol, symbol_name_str, lib_entry, options, lazy, ix == 0 ? rename : NULL);
+    LEAVE;
+    ST(0) = sv_2mortal(newRV_inc(MUTABLE_SV(cv_new)));
+    XSRETURN(1);
+}
 
-        for (SSize_t i = 0; i < num_args; ++i) {
-            SV ** type_sv_ptr = av_fetch(args_av, i, 0);
-            if (!type_sv_ptr)
-                continue;
-            const char * arg_sig = _get_string_from_type_obj(aTHX_ * type_sv_ptr);
-            if (!arg_sig)
-                croak("Argument %d in signature array is not a valid Affix::Type object", (int)i + 1);
-            strcat(signature_buf, arg_sig);
-            if (i < num_args - 1)
-                strcat(signature_buf, ",");
+/**
+ * @brief Binds a table of functions in one call: `Affix::bind_all($lib, \%table, [package => $name], [%options])`.
+ *
+ * The table maps symbol names to signatures, as strings, type objects or `[\@args => $ret]`.
+ * The library is opened once, each function is installed as a sub in `package` (the caller's
+ * by default), and bindings that share a signature share one plan, so the table costs one
+ * parse and JIT compile per distinct signature. `%options` are applied to every binding; with
+ * `lazy`, variadic functions are still bound up front.
+ *
+ * Every entry is checked before the first sub is installed, so a bad entry croaks with none of
+ * the table bound. Returns the names the library does not export.
+ */
+XS_INTERNAL(Affix_bind_all) {
+    dXSARGS;
+    if (items < 2 || items % 2 != 0 || !SvROK(ST(1)) || SvTYPE(SvRV(ST(1))) != SVt_PVHV)
+        croak_xs_usage(cv, "$lib, \\%table, [package => $name], [%options]");
+    SV * target_sv = ST(0);
+    HV * table = (HV *)SvRV(ST(1));
+    const char * package = NULL;
+    HV * options = NULL;
+    HV * eager_options = NULL;  // `options` without `lazy`, for the functions that can't wait
+    for (I32 i = 2; i < items; i += 2) {
+        const char * key = SvPV_nolen(ST(i));
+        if (strEQ(key, "package")) {
+            package = SvPV_nolen(ST(i + 1));
+            continue;
         }
-        strcat(signature_buf, ") -> ");
-
-        const char * ret_sig = _get_string_from_type_obj(aTHX_ ret_sv);
-        if (!ret_sig)
-            croak("Return type is not a valid Affix::Type object");
-        strcat(signature_buf, ret_sig);
-        signature = signature_buf;
+        if (!options)
+            options = (HV *)sv_2mortal((SV *)newHV());
+        (void)hv_store_ent(options, ST(i), newSVsv(ST(i + 1)), 0);
+        if (strEQ(key, "lazy"))
+            continue;
+        if (!eager_options)
+            eager_options = (HV *)sv_2mortal((SV *)newHV());
+        (void)hv_store_ent(eager_options, ST(i), newSVsv(ST(i + 1)), 0);
     }
-    else {
-        SV * signature_sv = ST(2);
-        signature = _get_string_from_type_obj(aTHX_ signature_sv);
-        if (signature == NULL)
-            signature = SvPV_nolen(signature_sv);
+    if (options) {
+        SV * error = _affix_check_options(aTHX_ options);
+        if (error)
+            croak_sv(error);
     }
+    SV ** lazy_sv = options ? hv_fetchs(options, "lazy", 0) : NULL;
+    bool lazy = lazy_sv && SvTRUE(*lazy_sv);
+    if (package == NULL)
+        package = CopSTASHPV(PL_curcop);
 
-    Affix * affix;
-    Newxz(affix, 1, Affix);
-    affix->return_sv = newSV(0);  // Kept for safety, though hot path uses TARG
-
-    if (created_implicit_handle)
-        affix->lib_handle = lib_handle_for_symbol;
+    LibRegistryEntry * lib_entry;
+    if (sv_isobject(target_sv) && sv_derived_from(target_sv, "Affix::Lib")) {
+        lib_entry = _lib_entry_from_sv(aTHX_ target_sv);
+        if (lib_entry)
+            lib_entry->ref_count++;
+    }
     else
-        affix->lib_handle = NULL;
-
-    infix_status status = infix_forward_create(&affix->infix, signature, symbol, MY_CXT.registry);
-
-    if (status != INFIX_SUCCESS) {
-        SvREFCNT_dec(affix->return_sv);
-        safefree(affix);
-        croak("Failed to parse signature or create trampoline: %s", infix_get_last_error().message);
+        lib_entry = _lib_registry_acquire(aTHX_ SvOK(target_sv) ? SvPV_nolen(target_sv) : NULL);
+    if (lib_entry == NULL)
+        croak("Failed to load library: %s", infix_get_last_error().message);
+    // Each binding takes its own reference; ours is dropped once we are done, croak or not.
+    ENTER;
+    SAVEDESTRUCTOR_X(_lib_registry_release_any, lib_entry);
+
+    AV * pending = (AV *)sv_2mortal((SV *)newAV());  // (symbol name, signature, symbol, lazy) for each to bind
+    SV * name_sv = sv_2mortal(newSV(64));
+    SP -= items;
+    HE * he;
+    hv_iterinit(table);
+    while ((he = hv_iternext(table))) {
+        STRLEN len;
+        const char * symbol_name = HePV(he, len);
+        SV * spec = HeVAL(he);
+        const char * signature;
+        if (SvROK(spec) && SvTYPE(SvRV(spec)) == SVt_PVAV && !sv_isobject(spec)) {
+            AV * spec_av = (AV *)SvRV(spec);
+            if (av_count(spec_av) != 2)
+                croak("Binding for '%s' must be a signature or [\\@args => $ret]", symbol_name);
+            signature = _signature_from_list(aTHX_ * av_fetch(spec_av, 0, 0), *av_fetch(spec_av, 1, 0));
+        }
+        else
+            signature = _get_string_from_type_obj(aTHX_ spec);
+
+        STRLEN semi, close;
+        bool variadic = _variadic_split(signature, &semi, &close);
+        bool bind_lazy = lazy && !variadic;
+        void * symbol = bind_lazy ? NULL : infix_library_get_symbol(lib_entry->lib, symbol_name);
+        if (symbol == NULL && !bind_lazy) {
+            mXPUSHs(newSVpvn(symbol_name, len));
+            continue;
+        }
+        // Whatever _new_binding() could croak on, short of running out of memory. Lazy bindings defer all but
+        // the options, and whether a pure one's arguments are numbers and strings.
+        if (variadic) {
+            if (eager_options)
+                croak("Binding options are not supported for variadic functions");
+            (void)_variadic_num_fixed(aTHX_ signature, semi, close);
+        }
+        else if (!bind_lazy) {
+            const Affix * plan = (const Affix *)CvXSUBANY(_unbound_trigger(aTHX_ signature)).any_ptr;
+            UV capacity;
+            SV * error = eager_options ? _affix_options_error(aTHX_ plan, eager_options, &capacity) : NULL;
+            if (error)
+                croak("Cannot bind '%s': %" SVf, symbol_name, SVfARG(error));
+        }
+        else if (options) {
+            UV capacity;
+            SV * error = _affix_options_preflight(aTHX_ options, &capacity);
+            if (error == NULL && capacity > 0 && (error = _lazy_pure_error(aTHX_ signature)))
+                croak("Cannot bind '%s': %" SVf, symbol_name, SVfARG(error));
+        }
+        av_push(pending, newSVpvn(symbol_name, len));
+        av_push(pending, newSVpv(signature, 0));
+        av_push(pending, newSVuv(PTR2UV(symbol)));
+        av_push(pending, newSViv(bind_lazy));
+    }
+    for (Size_t i = 0; i < av_count(pending); i += 4) {
+        SV ** entry = AvARRAY(pending) + i;
+        const char * symbol_name = SvPVX(entry[0]);
+        bool bind_lazy = SvIVX(entry[3]);
+        sv_setpvf(name_sv, "%s::%s", package, symbol_name);
+        (void)_new_binding(aTHX_ SvPVX(entry[1]),
+                           INT2PTR(void *, SvUVX(entry[2])),
+                           symbol_name,
+                           lib_entry,
+                           bind_lazy ? options : eager_options,
+                           bind_lazy,
+                           SvPVX(name_sv));
     }
+    LEAVE;
+    PUTBACK;
+}
 
-    affix->cif = infix_forward_get_code(affix->infix);
-    affix->num_args = infix_forward_get_num_args(affix->infix);
-    affix->ret_type = infix_forward_get_return_type(affix->infix);
-
-    // OPTIMIZATION: Pre-resolve the return handler here to avoid switch/lookup in hot path
-    affix->ret_pull_handler = get_pull_handler(affix->ret_type);
-    if (affix->ret_pull_handler == NULL) {
-        infix_forward_destroy(affix->infix);
-        SvREFCNT_dec(affix->return_sv);
-        safefree(affix);
-        croak("Unsupported return type in signature");
-    }
+/**
+ * @brief Calls a raw function pointer: `Affix::call_ptr($fnptr, $signature, @args)`.
+ *
+ * Plans are cached per signature on unbound trampolines, so calling many distinct
+ * function pointers that share a signature costs one hash lookup rather than a JIT compile.
+ */
+XS_INTERNAL(Affix_call_ptr) {
+    dXSARGS;
+    dMY_CXT;
+    if (items < 2)
+        croak_xs_usage(cv, "fnptr, signature, ...");
+    Affix_Pin * pin = _get_pin_from_sv(aTHX_ ST(0));
+    if (!pin || !pin->pointer)
+        croak("call_ptr expects a pin holding a native function pointer");
+    const char * signature = _get_string_from_type_obj(aTHX_ ST(1));
 
-    if (affix->num_args > 0)
-        Newx(affix->c_args, affix->num_args, void *);
-    else
-        affix->c_args = NULL;
+    CV * trigger = _unbound_trigger(aTHX_ signature);
+    ((Affix *)CvXSUBANY(trigger).any_ptr)->target = pin->pointer;
 
-    affix->args_arena = infix_arena_create(4096);
-    affix->ret_arena = infix_arena_create(1024);
-    if (!affix->args_arena || !affix->ret_arena)
-        croak("Failed to create memory arenas for FFI call");
+    // Run the plan on the call arguments in place: the new mark hides the pointer and signature.
+    EXTEND(SP, 1);
+    PUSHMARK(PL_stack_base + ax + 1);
+    Affix_trigger(aTHX_ trigger);
+    ST(0) = ST(2);
+    XSRETURN(1);
+}
 
-    // OPTIMIZATION: Plan length is exactly num_args.
-    // We do not create steps for "call" or "return".
-    affix->plan_length = affix->num_args;
-    if (affix->plan_length > 0)
-        Newxz(affix->plan, affix->plan_length, Affix_Plan_Step);
-    else
-        affix->plan = NULL;
+/// @brief True if a raw value of type `from` can be handed on unchanged as an argument of type `to`.
+static bool _chain_link_compatible(const infix_type * from, const infix_type * to) {
+    if (from->category == INFIX_TYPE_POINTER && to->category == INFIX_TYPE_POINTER)
+        return true;
+    char from_sig[256], to_sig[256];
+    if (infix_type_print(from_sig, sizeof(from_sig), (infix_type *)from, INFIX_DIALECT_SIGNATURE) != INFIX_SUCCESS ||
+        infix_type_print(to_sig, sizeof(to_sig), (infix_type *)to, INFIX_DIALECT_SIGNATURE) != INFIX_SUCCESS)
+        return false;
+    return strEQ(from_sig, to_sig);
+}
+/**
+ * @brief The XSUB installed for a chain of bindings.
+ *
+ * Only the first stage is marshalled from Perl. Each following stage takes the previous raw
+ * C return value as its single argument, and only the last result is turned into an SV.
+ */
+static void Affix_trigger_chain(pTHX_ CV * cv) {
+    dSP;
+    dAXMARK;
+    dXSTARG;
+    Affix_Chain * chain = (Affix_Chain *)CvXSUBANY(cv).any_ptr;
+    Affix * first = chain->stages[0];
 
-    size_t current_offset = 0;
-    for (size_t i = 0; i < affix->num_args; ++i) {
-        const infix_type * type = infix_forward_get_arg_type(affix->infix, i);
-        size_t alignment = (type->category == INFIX_TYPE_ARRAY) ? type->alignment : infix_type_get_alignment(type);
-        if (alignment == 0)
-            alignment = 1;
+    if (UNLIKELY((SP - MARK) != first->num_args))
+        croak("Wrong number of arguments. Expected %d, got %d", (int)first->num_args, (int)(SP - MARK));
 
-        current_offset = (current_offset + alignment - 1) & ~(alignment - 1);
-        affix->plan[i].data.c_arg_offset = current_offset;
+    SV ** perl_stack_frame = &ST(0);
+    void * args_buffer = alloca(first->total_args_size ? first->total_args_size : 1);
+    void ** c_args = (void **)alloca((first->num_args + 1) * sizeof(void *));
+    void * ret_buffer = alloca(chain->max_ret_size);
+    void * next_buffer = alloca(chain->max_ret_size);
 
-        size_t size = (type->category == INFIX_TYPE_ARRAY) ? type->size : infix_type_get_size(type);
-        current_offset += size;
+    for (size_t i = 0; i < first->num_args; ++i) {
+        Affix_Plan_Step * step = &first->plan[i];
+        step->executor(aTHX_ first, step, perl_stack_frame, args_buffer, c_args, ret_buffer);
     }
-    affix->total_args_size = current_offset;
-
-    // Setup Execution Plan
-    size_t out_param_count = 0;
-    OutParamInfo * temp_out_info = safemalloc(sizeof(OutParamInfo) * (affix->num_args > 0 ? affix->num_args : 1));
+    _affix_call(first, ret_buffer, c_args);
+    if (first->num_out_params > 0)
+        _writeback_out_params(aTHX_ first, perl_stack_frame, c_args);
 
-    for (size_t i = 0; i < affix->num_args; ++i) {
-        const infix_type * type = infix_forward_get_arg_type(affix->infix, i);
-        affix->plan[i].executor = get_plan_step_executor(type);
-        affix->plan[i].opcode = get_opcode_for_type(type);
+    for (size_t i = 1; i < chain->num_stages; ++i) {
+        void * link = ret_buffer;
+        _affix_call(chain->stages[i], next_buffer, &link);
+        ret_buffer = next_buffer;
+        next_buffer = link;
+    }
 
-        if (affix->plan[i].executor == NULL) {
-            safefree(temp_out_info);
-            infix_forward_destroy(affix->infix);
-            SvREFCNT_dec(affix->return_sv);
-            infix_arena_destroy(affix->args_arena);
-            infix_arena_destroy(affix->ret_arena);
-            if (affix->plan)
-                safefree(affix->plan);
-            safefree(affix);
-            croak("Unsupported argument type in signature at index %zu", i);
+    Affix * last = chain->stages[chain->num_stages - 1];
+    last->ret_pull_handler(aTHX_ last, TARG, last->ret_type, ret_buffer);
+    ST(0) = TARG;
+    PL_stack_sp = PL_stack_base + ax;
+}
+/**
+ * @brief Composes bindings into one XSUB: `Affix::chain($h, $g, $f)` behaves like `f(g(h(@_)))`.
+ *
+ * Every stage after the first must take exactly one argument compatible with the previous
+ * stage's return type.
+ */
+XS_INTERNAL(Affix_chain) {
+    dXSARGS;
+    if (items < 1)
+        croak_xs_usage(cv, "binding, ...");
+
+    Affix_Chain * chain;
+    Newxz(chain, 1, Affix_Chain);
+    Newxz(chain->stages, items, Affix *);
+    Newxz(chain->cvs, items, CV *);
+    // Own the chain from the start so a croak below releases it.
+    CV * cv_new = newXSproto_portable(NULL, Affix_trigger_chain, __FILE__, NULL);
+    CvXSUBANY(cv_new).any_ptr = (void *)chain;
+    _binding_set_dup(aTHX_ cv_new);
+    SV * obj = sv_2mortal(newRV_noinc(MUTABLE_SV(cv_new)));
+    sv_bless(obj, gv_stashpv("Affix::Chain", GV_ADD));
+
+    chain->max_ret_size = sizeof(void *);
+    for (I32 i = 0; i < items; ++i) {
+        SV * binding = ST(i);
+        Affix * affix = _affix_from_binding(aTHX_ binding);
+        if (!affix)
+            croak("Argument %d to chain is not an Affix binding", (int)i + 1);
+        if (i > 0) {
+            const infix_type * prev_ret = chain->stages[i - 1]->ret_type;
+            if (affix->num_args != 1)
+                croak("Stage %d of chain must take exactly one argument", (int)i + 1);
+            if (prev_ret->category == INFIX_TYPE_VOID ||
+                !_chain_link_compatible(prev_ret, infix_forward_get_arg_type(affix->infix, 0)))
+                croak("Stage %d of chain cannot take the return value of stage %d", (int)i + 1, (int)i);
         }
+        chain->stages[i] = affix;
+        chain->cvs[i] = (CV *)SvREFCNT_inc_simple_NN(SvRV(binding));
+        chain->num_stages++;
+        if (affix->ret_type->size > chain->max_ret_size)
+            chain->max_ret_size = affix->ret_type->size;
+    }
+    ST(0) = obj;
+    XSRETURN(1);
+}
 
-        affix->plan[i].data.type = type;
-        affix->plan[i].data.index = i;
+XS_INTERNAL(Affix_Chain_DESTROY) {
+    dXSARGS;
+    PERL_UNUSED_VAR(items);
+    CV * cv_ptr = (CV *)SvRV(ST(0));
+    Affix_Chain * chain = (Affix_Chain *)CvXSUBANY(cv_ptr).any_ptr;
+    if (chain != NULL) {
+        CvXSUBANY(cv_ptr).any_ptr = NULL;
+        for (size_t i = 0; i < chain->num_stages; ++i)
+            SvREFCNT_dec(chain->cvs[i]);
+        safefree(chain->cvs);
+        safefree(chain->stages);
+        safefree(chain);
+    }
+    XSRETURN_EMPTY;
+}
 
-        if (type->category == INFIX_TYPE_POINTER) {
-            const infix_type * pointee_type = type->meta.pointer_info.pointee_type;
-            if (pointee_type->category != INFIX_TYPE_REVERSE_TRAMPOLINE && pointee_type->category != INFIX_TYPE_VOID) {
-                temp_out_info[out_param_count].perl_stack_index = i;
-                temp_out_info[out_param_count].pointee_type = pointee_type;
-                temp_out_info[out_param_count].writer = get_out_param_writer(pointee_type);
-                out_param_count++;
-            }
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//                   LAZY BINDINGS RESOLVED ON FIRST CALL
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+ * @brief Counts the arguments of a signature from its text alone, without parsing any types.
+ *
+ * @return The number of top-level arguments, or -1 if the text does not open with an argument list.
+ */
+static int _signature_arity(const char * signature) {
+    const char * p = signature;
+    while (isSPACE(*p))
+        ++p;
+    if (*p != '(')
+        return -1;
+    int depth = 0, commas = 0;
+    bool empty = true;
+    for (; *p; ++p) {
+        if (*p == '(' || *p == '{' || *p == '[' || *p == '<')
+            depth++;
+        else if (*p == ')' || *p == '}' || *p == ']' || (*p == '>' && p[-1] != '-')) {
+            if (--depth == 0)
+                return empty ? 0 : commas + 1;
         }
+        else if (depth == 1 && *p == ',')
+            commas++;
+        else if (depth == 1 && *p == ';')
+            return -1;
+        if (depth > 1 || (depth == 1 && *p != '(' && !isSPACE(*p)))
+            empty = false;
+    }
+    return -1;
+}
+static void _lazy_free(pTHX_ Affix_Lazy * pending) {
+    _lib_registry_release(aTHX_ pending->lib_entry);
+    SvREFCNT_dec(pending->options);
+    safefree(pending->signature);
+    safefree(pending->symbol_name);
+    safefree(pending);
+}
+/**
+ * @brief Checks the arguments of a lazy pure binding as _affix_options_error() would, parsing but not compiling.
+ *
+ * A signature naming types that are not defined yet is checked again when the binding resolves.
+ */
+static SV * _lazy_pure_error(pTHX_ const char * signature) {
+    dMY_CXT;
+    infix_arena_t * parse_arena = NULL;
+    infix_type * ret_type = NULL;
+    infix_function_argument * args = NULL;
+    size_t num_args = 0, num_fixed = 0;
+    if (infix_signature_parse(signature, &parse_arena, &ret_type, &args, &num_args, &num_fixed, MY_CXT.registry) !=
+        INFIX_SUCCESS) {
+        if (parse_arena)
+            infix_arena_destroy(parse_arena);
+        return NULL;
     }
+    SV * error = NULL;
+    for (size_t i = 0; i < num_args && error == NULL; ++i)
+        error = _pure_arg_error(aTHX_ args[i].type, i);
+    infix_arena_destroy(parse_arena);
+    return error;
+}
+/// @brief Builds the stub a lazy binding starts out as: nothing is looked up or compiled yet.
+static CV * _new_lazy_binding(pTHX_ const char * signature, const char * symbol_name, void * symbol,
+                              HV * options, const char * name) {
+    UV capacity;
+    SV * error = _affix_options_preflight(aTHX_ options, &capacity);
+    if (error == NULL && capacity > 0)
+        error = _lazy_pure_error(aTHX_ signature);
+    if (error)
+        croak_sv(error);
+    Affix_Lazy * pending;
+    Newxz(pending, 1, Affix_Lazy);
+    pending->signature = savepv(signature);
+    pending->symbol_name = savepv(symbol_name);
+    pending->symbol = symbol;
+    pending->options = newHVhv(options);
+
+    // The stub gets the same prototype the real binding would have.
+    int arity = _signature_arity(signature);
+    CV * cv_new = newXSproto_portable(
+        name, Affix_trigger_lazy, __FILE__, arity < 0 ? NULL : _scalar_prototype(aTHX_(size_t) arity, false));
+    if (UNLIKELY(cv_new == NULL))
+        croak("Failed to install new XSUB");
+    CvXSUBANY(cv_new).any_ptr = (void *)pending;
+    return cv_new;
+}
+/// @brief Turns a lazy binding into an ordinary one in place, so later calls go straight to Affix_trigger().
+static Affix * _lazy_resolve(pTHX_ CV * cv) {
+    Affix_Lazy * pending = (Affix_Lazy *)CvXSUBANY(cv).any_ptr;
+    void * symbol = pending->symbol;
+    if (symbol == NULL)
+        symbol = infix_library_get_symbol(pending->lib_entry->lib, pending->symbol_name);
+    if (symbol == NULL)
+        croak("Failed to locate symbol '%s' for a lazy binding", pending->symbol_name);
+    Affix * affix = _new_bound_affix(aTHX_ pending->signature, symbol);
+    SV * error = _affix_apply_options(aTHX_ affix, pending->options);
+    if (error) {
+        _destroy_affix(aTHX_ affix);
+        croak_sv(error);
+    }
+    affix->lib_entry = pending->lib_entry;
+    pending->lib_entry = NULL;
+    _lazy_free(aTHX_ pending);
+    CvXSUBANY(cv).any_ptr = (void *)affix;
+    CvXSUB(cv) = Affix_trigger;
+    return affix;
+}
+/// @brief The first call of a lazy binding: resolve and compile it, then run the call as usual.
+static void Affix_trigger_lazy(pTHX_ CV * cv) {
+    _lazy_resolve(aTHX_ cv);
+    Affix_trigger(aTHX_ cv);
+}
 
-    affix->num_out_params = out_param_count;
-    if (out_param_count > 0) {
-        affix->out_param_info = safemalloc(sizeof(OutParamInfo) * out_param_count);
-        memcpy(affix->out_param_info, temp_out_info, sizeof(OutParamInfo) * out_param_count);
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//                   VARIADIC BINDINGS SHAPED AT CALL TIME
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/// @brief How many distinct argument shapes a variadic binding keeps trampolines for.
+#define AFFIX_VARIADIC_SHAPES 16
+
+/**
+ * @brief Finds an empty variadic part in a signature, as in `(*char;) -> int`.
+ *
+ * @param[out] semi Offset of the `;` that opens the variadic part.
+ * @param[out] close Offset of the parenthesis that closes the argument list.
+ * @return true if the signature leaves its variadic arguments to be decided per call.
+ */
+static bool _variadic_split(const char * signature, STRLEN * semi, STRLEN * close) {
+    const char * found = NULL;
+    int depth = 0;
+    for (const char * p = signature; *p; ++p) {
+        if (*p == '(' || *p == '{' || *p == '[' || *p == '<')
+            depth++;
+        else if (*p == ')' || *p == '}' || *p == ']' || (*p == '>' && (p == signature || p[-1] != '-'))) {
+            if (--depth > 0)
+                continue;
+            if (found == NULL)
+                return false;
+            for (const char * q = found + 1; q < p; ++q)
+                if (!isSPACE(*q))
+                    return false;
+            *semi = found - signature;
+            *close = p - signature;
+            return true;
+        }
+        else if (*p == ';' && depth == 1)
+            found = p;
     }
+    return false;
+}
+/**
+ * @brief Picks the C type of a variadic argument from its value.
+ *
+ * An `Affix::Typed` wrapper from typed() names the type outright, and its value replaces it on
+ * the stack. Otherwise integers are passed as int (or long long when they do not fit), other
+ * numbers as double, strings as char*, and pins and undef as void*.
+ */
+static const char * _variadic_arg_type(pTHX_ SV ** slot, size_t position) {
+    SV * sv = *slot;
+    if (sv_isobject(sv) && sv_derived_from(sv, "Affix::Typed")) {
+        AV * typed = (AV *)SvRV(sv);
+        SV ** type = av_fetch(typed, 0, 0);
+        SV ** value = av_fetch(typed, 1, 0);
+        *slot = value ? *value : &PL_sv_undef;
+        return type ? SvPV_nolen(*type) : "*void";
+    }
+    if (is_pin(aTHX_ sv) || !SvOK(sv))
+        return "*void";
+    if (SvROK(sv))
+        croak("Cannot pass a reference as variadic argument %d; wrap it with typed()", (int)position);
+    // Strings first: one used as a number is still IOK/NOK. A stringified number only gets POKp.
+    if (SvPOK(sv))
+        return "*char";
+    if (SvIOK(sv) && !SvNOK(sv)) {
+        if (SvIsUV(sv))
+            return SvUVX(sv) <= UINT_MAX ? "uint" : "ulonglong";
+        return (SvIVX(sv) >= INT_MIN && SvIVX(sv) <= INT_MAX) ? "int" : "longlong";
+    }
+    if (SvNOK(sv))
+        return "double";
+    croak("Cannot infer the C type of variadic argument %d; wrap it with typed()", (int)position);
+    return NULL;
+}
+/**
+ * @brief The XSUB installed for a variadic binding without a fixed shape.
+ *
+ * The concrete signature of each call is derived from its arguments and used to look up a
+ * trampoline in the binding's LRU of recent shapes, so a handful of recurring shapes costs
+ * one hash lookup per call rather than a JIT compile. The call then runs through the ordinary
+ * plan of that shape.
+ */
+static void Affix_trigger_variadic(pTHX_ CV * cv) {
+    dXSARGS;
+    Affix_Variadic * variadic = (Affix_Variadic *)CvXSUBANY(cv).any_ptr;
+    if (UNLIKELY((size_t)items < variadic->num_fixed))
+        croak("Wrong number of arguments. Expected at least %d, got %d", (int)variadic->num_fixed, (int)items);
+
+    Affix_Memo * shapes = variadic->shapes;
+    sv_setpvn(shapes->key, variadic->prefix, variadic->prefix_len);
+    for (I32 i = (I32)variadic->num_fixed; i < items; ++i) {
+        sv_catpvn(shapes->key, i == (I32)variadic->num_fixed ? ";" : ",", 1);
+        sv_catpv(shapes->key, _variadic_arg_type(aTHX_ &ST(i), i + 1));
+    }
+    sv_catpv(shapes->key, variadic->suffix);
+
+    CV * trigger;
+    Affix_Memo_Entry * entry = _memo_lookup(aTHX_ shapes);
+    if (entry)
+        trigger = (CV *)SvRV(entry->value);
     else {
-        affix->out_param_info = NULL;
+        Affix * affix = _new_bound_affix(aTHX_ SvPVX(shapes->key), variadic->symbol);
+        trigger = newXSproto_portable(NULL, Affix_trigger, __FILE__, NULL);
+        CvXSUBANY(trigger).any_ptr = (void *)affix;
+        SV * obj = sv_2mortal(newRV_noinc(MUTABLE_SV(trigger)));
+        sv_bless(obj, gv_stashpv("Affix", GV_ADD));
+        _memo_store(aTHX_ shapes, obj);
+    }
+    // A nested call may evict this shape before we are done with it.
+    sv_2mortal(SvREFCNT_inc_simple_NN(MUTABLE_SV(trigger)));
+
+    // Run the shape's plan on our own arguments.
+    PUSHMARK(MARK);
+    Affix_trigger(aTHX_ trigger);
+}
+/// @brief Builds the binding for a signature whose variadic part is decided per call.
+/// @brief Parses the fixed part of a variadic signature split by _variadic_split(), or croaks.
+/// @return The number of fixed arguments.
+static size_t _variadic_num_fixed(pTHX_ const char * signature, STRLEN semi, STRLEN close) {
+    dMY_CXT;
+    SV * fixed = sv_2mortal(newSVpvn(signature, semi));
+    sv_catpv(fixed, signature + close);
+    infix_arena_t * parse_arena = NULL;
+    infix_type * ret_type = NULL;
+    infix_function_argument * args = NULL;
+    size_t num_args = 0, num_fixed = 0;
+    if (infix_signature_parse(
+            SvPVX(fixed), &parse_arena, &ret_type, &args, &num_args, &num_fixed, MY_CXT.registry) != INFIX_SUCCESS)
+        croak("Failed to parse signature: %s", infix_get_last_error().message);
+    infix_arena_destroy(parse_arena);
+    return num_args;
+}
+static CV * _new_variadic_binding(pTHX_ const char * signature, STRLEN semi, STRLEN close, void * symbol,
+                                  const char * name) {
+    // Validate the fixed part up front, and count it.
+    size_t num_args = _variadic_num_fixed(aTHX_ signature, semi, close);
+
+    Affix_Variadic * variadic;
+    Newxz(variadic, 1, Affix_Variadic);
+    variadic->symbol = symbol;
+    variadic->prefix = savepvn(signature, semi);
+    variadic->prefix_len = semi;
+    variadic->suffix = savepv(signature + close);
+    variadic->num_fixed = num_args;
+    variadic->shapes = _memo_new(aTHX_ AFFIX_VARIADIC_SHAPES);
+
+    CV * cv_new = newXSproto_portable(name, Affix_trigger_variadic, __FILE__, _scalar_prototype(aTHX_ num_args, true));
+    CvXSUBANY(cv_new).any_ptr = (void *)variadic;
+    return cv_new;
+}
+
+XS_INTERNAL(Affix_Variadic_DESTROY) {
+    dXSARGS;
+    PERL_UNUSED_VAR(items);
+    CV * cv_ptr = (CV *)SvRV(ST(0));
+    Affix_Variadic * variadic = (Affix_Variadic *)CvXSUBANY(cv_ptr).any_ptr;
+    if (variadic != NULL) {
+        CvXSUBANY(cv_ptr).any_ptr = NULL;
+        _memo_destroy(aTHX_ variadic->shapes);
+        _lib_registry_release(aTHX_ variadic->lib_entry);
+        safefree(variadic->prefix);
+        safefree(variadic->suffix);
+        safefree(variadic);
     }
-    safefree(temp_out_info);
+    XSRETURN_EMPTY;
+}
 
-    // Create XSUB
-    char prototype_buf[256] = {0};
-    for (size_t i = 0; i < affix->num_args; ++i)
-        strcat(prototype_buf, "$");
+/// @brief `Affix::typed($type, $value)` pins down the C type of one variadic argument.
+XS_INTERNAL(Affix_typed) {
+    dXSARGS;
+    if (items != 2)
+        croak_xs_usage(cv, "type, value");
+    AV * typed = newAV();
+    av_push(typed, newSVpv(_get_string_from_type_obj(aTHX_ ST(0)), 0));
+    av_push(typed, newSVsv(ST(1)));
+    SV * obj = sv_2mortal(newRV_noinc(MUTABLE_SV(typed)));
+    sv_bless(obj, gv_stashpv("Affix::Typed", GV_ADD));
+    ST(0) = obj;
+    XSRETURN(1);
+}
 
-    CV * cv_new = newXSproto_portable(ix == 0 ? rename : NULL, Affix_trigger, __FILE__, prototype_buf);
-    if (UNLIKELY(cv_new == NULL))
-        croak("Failed to install new XSUB");
+/// @brief The result cache of a pure binding or the shape cache of a variadic one, else NULL.
+static Affix_Memo * _memo_from_binding(pTHX_ SV * binding, bool * is_binding) {
+    Affix * affix = _affix_from_binding(aTHX_ binding);
+    if (affix) {
+        *is_binding = true;
+        return affix->memo;
+    }
+    if (sv_isobject(binding) && SvTYPE(SvRV(binding)) == SVt_PVCV &&
+        CvXSUB((CV *)SvRV(binding)) == Affix_trigger_variadic) {
+        *is_binding = true;
+        return ((Affix_Variadic *)CvXSUBANY((CV *)SvRV(binding)).any_ptr)->shapes;
+    }
+    *is_binding = false;
+    return NULL;
+}
 
-    CvXSUBANY(cv_new).any_ptr = (void *)affix;
-    SV * obj = newRV_inc(MUTABLE_SV(cv_new));
-    sv_bless(obj, gv_stashpv("Affix", GV_ADD));
-    ST(0) = sv_2mortal(obj);
+XS_INTERNAL(Affix_memo_stats) {
+    dXSARGS;
+    if (items != 1)
+        croak_xs_usage(cv, "binding");
+    bool is_binding;
+    Affix_Memo * memo = _memo_from_binding(aTHX_ ST(0), &is_binding);
+    if (!is_binding)
+        croak("memo_stats expects an Affix binding");
+    if (!memo)
+        XSRETURN_UNDEF;
+    HV * stats = newHV();
+    hv_stores(stats, "hits", newSVuv(memo->hits));
+    hv_stores(stats, "misses", newSVuv(memo->misses));
+    hv_stores(stats, "size", newSVuv(memo->count));
+    hv_stores(stats, "capacity", newSVuv(memo->capacity));
+    ST(0) = sv_2mortal(newRV_noinc(MUTABLE_SV(stats)));
     XSRETURN(1);
 }
 
+XS_INTERNAL(Affix_memo_clear) {
+    dXSARGS;
+    if (items != 1)
+        croak_xs_usage(cv, "binding");
+    bool is_binding;
+    Affix_Memo * memo = _memo_from_binding(aTHX_ ST(0), &is_binding);
+    if (!is_binding)
+        croak("memo_clear expects an Affix binding");
+    if (memo) {
+        _memo_clear(aTHX_ memo);
+        memo->hits = memo->misses = 0;
+    }
+    XSRETURN_EMPTY;
+}
+
 XS_INTERNAL(Affix_Bundled_DESTROY) {
     dXSARGS;
     PERL_UNUSED_VAR(items);
     Affix_Backend * backend;
+    CV * cv_ptr;
     STMT_START {
         HV * st;
         GV * gvp;
         SV * const xsub_tmp_sv = ST(0);
         SvGETMAGIC(xsub_tmp_sv);
-        CV * cv_ptr = sv_2cv(xsub_tmp_sv, &st, &gvp, 0);
+        cv_ptr = sv_2cv(xsub_tmp_sv, &st, &gvp, 0);
         backend = (Affix_Backend *)CvXSUBANY(cv_ptr).any_ptr;
     }
     STMT_END;
 
     if (backend) {
-        if (backend->infix)
-            infix_forward_destroy(backend->infix);
-        // lib_handle cleanup would also go here.
+        CvXSUBANY(cv_ptr).any_ptr = NULL;
+        _affix_core_release(aTHX_ backend->core);
+        if (backend->arg_types)
+            safefree(backend->arg_types);
+        _lib_registry_release(aTHX_ backend->lib_entry);
         safefree(backend);
     }
     XSRETURN_EMPTY;
 }
 
+/// @brief Drops one reference on a library entry, closing the library with the last one.
+static void _lib_registry_release(pTHX_ LibRegistryEntry * entry) {
+    dMY_CXT;
+    if (entry == NULL || --entry->ref_count > 0)
+        return;
+    // Clones and entries orphaned at END are not (or no longer) the registry's.
+    if (MY_CXT.lib_registry != NULL) {
+        SV ** entry_sv_ptr = hv_fetch(MY_CXT.lib_registry, entry->path, strlen(entry->path), 0);
+        if (entry_sv_ptr && INT2PTR(LibRegistryEntry *, SvIV(*entry_sv_ptr)) == entry)
+            hv_delete(MY_CXT.lib_registry, entry->path, strlen(entry->path), G_DISCARD);
+    }
+    infix_library_close(entry->lib);
+    safefree(entry->path);
+    safefree(entry);
+}
+/// @brief _lib_registry_release() for SAVEDESTRUCTOR_X().
+static void _lib_registry_release_any(pTHX_ void * entry) { _lib_registry_release(aTHX_(LibRegistryEntry *) entry); }
+
+/// @brief Drops one binding's hold on a shared core, freeing it with the last one.
+static void _affix_core_release(pTHX_ Affix_Core * core) {
+    OP_REFCNT_LOCK;
+    UV left = --core->ref_count;
+    OP_REFCNT_UNLOCK;
+    if (left > 0)
+        return;
+    if (core->infix != NULL)
+        infix_forward_destroy(core->infix);
+    for (size_t i = 0; i < core->plan_length; ++i)
+        if (core->plan[i].data.shared_callback != NULL)
+            _shared_callback_release(aTHX_ core->plan[i].data.shared_callback);
+    if (core->plan != NULL)
+        safefree(core->plan);
+    if (core->out_param_info != NULL)
+        safefree(core->out_param_info);
+    safefree(core);
+}
+
+/// @brief Frees a binding's plan and everything it owns, releasing its library handle.
+static void _destroy_affix(pTHX_ Affix * affix) {
+    _lib_registry_release(aTHX_ affix->lib_entry);
+    if (affix->return_sv)
+        SvREFCNT_dec(affix->return_sv);
+    if (affix->args_arena != NULL)
+        infix_arena_destroy(affix->args_arena);
+    if (affix->ret_arena != NULL)
+        infix_arena_destroy(affix->ret_arena);
+    if (affix->c_args != NULL)
+        safefree(affix->c_args);
+    if (affix->memo != NULL)
+        _memo_destroy(aTHX_ affix->memo);
+    _affix_core_release(aTHX_ affix->core);
+    safefree(affix);
+}
+
 XS_INTERNAL(Affix_DESTROY) {
     dXSARGS;
-    dMY_CXT;
     PERL_UNUSED_VAR(items);
     Affix * affix;
+    CV * cv_ptr;
     STMT_START {
         HV * st;
         GV * gvp;
         SV * const xsub_tmp_sv = ST(0);
         SvGETMAGIC(xsub_tmp_sv);
-        CV * cv_ptr = sv_2cv(xsub_tmp_sv, &st, &gvp, 0);
+        cv_ptr = sv_2cv(xsub_tmp_sv, &st, &gvp, 0);
         affix = (Affix *)CvXSUBANY(cv_ptr).any_ptr;
     }
     STMT_END;
-    if (affix != NULL) {
-        if (affix->lib_handle != NULL && MY_CXT.lib_registry != NULL) {
-            hv_iterinit(MY_CXT.lib_registry);
-            HE * he;
-            while ((he = hv_iternext(MY_CXT.lib_registry))) {
-                SV * entry_sv = HeVAL(he);
-                LibRegistryEntry * entry = INT2PTR(LibRegistryEntry *, SvIV(entry_sv));
-                if (entry->lib == affix->lib_handle) {
-                    entry->ref_count--;
-                    if (entry->ref_count == 0) {
-                        infix_library_close(entry->lib);
-                        safefree(entry);
-                        hv_delete_ent(MY_CXT.lib_registry, HeKEY_sv(he), G_DISCARD, 0);
-                    }
-                    break;
-                }
-            }
-        }
-        if (affix->return_sv)
-            SvREFCNT_dec(affix->return_sv);
-        if (affix->args_arena != NULL)
-            infix_arena_destroy(affix->args_arena);
-        if (affix->ret_arena != NULL)
-            infix_arena_destroy(affix->ret_arena);
-        if (affix->infix != NULL)
-            infix_forward_destroy(affix->infix);
-        if (affix->plan != NULL)
-            safefree(affix->plan);
-        if (affix->out_param_info != NULL)
-            safefree(affix->out_param_info);
-        if (affix->c_args != NULL)
-            safefree(affix->c_args);
-        safefree(affix);
-    }
+    if (affix == NULL)
+        XSRETURN_EMPTY;
+    CvXSUBANY(cv_ptr).any_ptr = NULL;
+    if (CvXSUB(cv_ptr) == Affix_trigger_lazy)
+        _lazy_free(aTHX_(Affix_Lazy *) affix);
+    else
+        _destroy_affix(aTHX_ affix);
     XSRETURN_EMPTY;
 }
 
@@ -1862,22 +3193,24 @@ static void pull_pointer_as_pin(pTHX_ Affix * affix, SV * sv, const infix_type *
     }
 
     // This is the default case for all other pointers (*int, **char, *void, etc.)
-    // It unconditionally creates a pin object.
+    // It unconditionally creates a pin object. The plan's graph dies with its binding, so the pin
+    // holds a reference on an interned one instead.
+    Affix_Type * ref = _type_intern_graph(aTHX_ type);
     Affix_Pin * pin;
     Newxz(pin, 1, Affix_Pin);
+    _pin_set_type(pin, ref);
 
     SV * obj_data = newSV(0);
     sv_setiv(obj_data, PTR2IV(pin));
 
 
     SV * rv = sv_2mortal(newRV_noinc(obj_data));
-    sv_magicext(obj_data, NULL, PERL_MAGIC_ext, &Affix_pin_vtbl, (const char *)pin, 0);
+    _pin_magicext(aTHX_ obj_data, pin);
 
     sv_setsv(sv, rv);
     sv_bless(sv, gv_stashpv("Affix::Pin", GV_ADD));
 
     pin->pointer = c_ptr;
-    pin->type = type;
     pin->managed = false;
 }
 
@@ -1992,12 +3325,14 @@ void sv2ptr(pTHX_ Affix * affix, SV * perl_sv, void * c_ptr, const infix_type *
             else if (SvPOK(perl_sv))
                 *(const char **)c_ptr = SvPV_nolen(perl_sv);
             else if (SvROK(perl_sv) && SvTYPE(SvRV(perl_sv)) == SVt_PVAV) {
+                // The array lives in a mortal buffer, so it is freed with the caller's temporaries.
                 AV * av = (AV *)SvRV(perl_sv);
                 size_t len = av_len(av) + 1;
                 size_t element_size = infix_type_get_size(pointee_type);
                 size_t total_size = len * element_size;
-                char * c_array;
-                Newx(c_array, total_size, char);
+                SV * buffer = sv_2mortal(newSV(total_size + 1));
+                char * c_array = SvPVX(buffer);
+                Zero(c_array, total_size, char);
                 for (size_t i = 0; i < len; ++i) {
                     SV ** elem_sv_ptr = av_fetch(av, i, 0);
                     if (elem_sv_ptr)
@@ -2016,6 +3351,9 @@ void sv2ptr(pTHX_ Affix * affix, SV * perl_sv, void * c_ptr, const infix_type *
     case INFIX_TYPE_STRUCT:
         push_struct(aTHX_ affix, type, perl_sv, c_ptr);
         break;
+    case INFIX_TYPE_UNION:
+        push_union(aTHX_ affix, type, perl_sv, c_ptr);
+        break;
     case INFIX_TYPE_ARRAY:
         push_array(aTHX_ affix, type, perl_sv, c_ptr);
         break;
@@ -2048,6 +3386,28 @@ void push_struct(pTHX_ Affix * affix, const infix_type * type, SV * sv, void * p
             sv2ptr(aTHX_ affix, *member_sv_ptr, member_ptr, member->type);
     }
 }
+/// @brief Marshals a one-key hash reference into the union member named by its key.
+void push_union(pTHX_ Affix * affix, const infix_type * type, SV * sv, void * p) {
+    if (!SvROK(sv) || SvTYPE(SvRV(sv)) != SVt_PVHV)
+        croak("Expected a HASH reference for union marshalling");
+    HV * hv = (HV *)SvRV(sv);
+    if (hv_iterinit(hv) == 0)
+        return;
+    HE * he = hv_iternext(hv);
+    if (!he)
+        return;
+    const char * key = HeKEY(he);
+    STRLEN key_len = HeKLEN(he);
+    SV * value_sv = HeVAL(he);
+    for (size_t i = 0; i < type->meta.aggregate_info.num_members; ++i) {
+        const infix_struct_member * member = &type->meta.aggregate_info.members[i];
+        if (member->name && strlen(member->name) == key_len && memcmp(member->name, key, key_len) == 0) {
+            sv2ptr(aTHX_ affix, value_sv, p, member->type);
+            return;
+        }
+    }
+    croak("Union member '%s' not found in type definition", key);
+}
 void push_array(pTHX_ Affix * affix, const infix_type * type, SV * sv, void * p) {
     const infix_type * element_type = type->meta.array_info.element_type;
     size_t c_array_len = type->meta.array_info.num_elements;
@@ -2083,6 +3443,75 @@ void push_array(pTHX_ Affix * affix, const infix_type * type, SV * sv, void * p)
         }
     }
 }
+static void _destroy_callback_entry(pTHX_ Implicit_Callback_Magic * entry) {
+    Affix_Callback_Data * cb_data = entry->cb_data;
+    if (cb_data) {
+        // During global destruction it may already be gone; refcounts no longer matter then.
+        if (PL_phase != PERL_PHASE_DESTRUCT && cb_data->user_data)
+            SvREFCNT_dec(cb_data->user_data);
+        safefree(cb_data);
+    }
+    if (entry->reverse_ctx)
+        infix_reverse_destroy(entry->reverse_ctx);
+    if (entry->signature)
+        safefree(entry->signature);
+    safefree(entry);
+}
+/**
+ * @brief Free magic for coderefs that own callback trampolines.
+ *
+ * Runs when the CV itself is freed (or when the magic is stripped by release_callback() or
+ * END) and tears down every trampoline that was generated for it. Trampolines hold no
+ * reference on the CV, so an anonymous sub takes its trampolines with it when it goes.
+ */
+static int Affix_free_callbacks(pTHX_ SV * sv, MAGIC * mg) {
+    dMY_CXT;
+    if (MY_CXT.callback_registry)
+        (void)hv_delete(MY_CXT.callback_registry, (const char *)&sv, sizeof(sv), G_DISCARD);
+    Implicit_Callback_Magic * entry = (Implicit_Callback_Magic *)mg->mg_ptr;
+    while (entry) {
+        Implicit_Callback_Magic * next = entry->next;
+        _destroy_callback_entry(aTHX_ entry);
+        entry = next;
+    }
+    mg->mg_ptr = NULL;
+    return 0;
+}
+/**
+ * @brief Frees a coderef's trampolines and user-data records now rather than with the CV.
+ *
+ * Croaks if one of them is running, since its code would be freed under it.
+ * @return The number of trampolines and records that were freed.
+ */
+IV _release_callback(pTHX_ CV * cv) {
+    MAGIC * mg = mg_findext((SV *)cv, PERL_MAGIC_ext, &Affix_callback_vtbl);
+    if (!mg)
+        return 0;
+    IV released = 0;
+    for (Implicit_Callback_Magic * entry = (Implicit_Callback_Magic *)mg->mg_ptr; entry; entry = entry->next) {
+        if (entry->cb_data && entry->cb_data->running)
+            croak("Cannot release a callback while it is running");
+        released++;
+    }
+    sv_unmagicext((SV *)cv, PERL_MAGIC_ext, &Affix_callback_vtbl);
+    return released;
+}
+static void _attach_callback_entry(pTHX_ SV * coderef_cv, MAGIC * mg, Implicit_Callback_Magic * entry) {
+    dMY_CXT;
+    if (!mg) {
+        mg = sv_magicext(coderef_cv, NULL, PERL_MAGIC_ext, &Affix_callback_vtbl, NULL, 0);
+        mg->mg_flags |= MGf_DUP;
+    }
+    // A CV cloned into a new ithread keeps the magic but none of the parent's entries.
+    if (!mg->mg_ptr)
+        (void)hv_store(MY_CXT.callback_registry,
+                       (const char *)&coderef_cv,
+                       sizeof(coderef_cv),
+                       newSViv(PTR2IV(coderef_cv)),
+                       0);
+    entry->next = (Implicit_Callback_Magic *)mg->mg_ptr;
+    mg->mg_ptr = (char *)entry;
+}
 void push_reverse_trampoline(pTHX_ Affix * affix, const infix_type * type, SV * sv, void * p) {
     PERL_UNUSED_VAR(affix);
     dMY_CXT;
@@ -2092,58 +3521,202 @@ void push_reverse_trampoline(pTHX_ Affix * affix, const infix_type * type, SV *
     else if (SvTYPE(sv) == SVt_PVCV)
         coderef_cv = sv;
     if (coderef_cv) {
-        char key[32];
-        snprintf(key, sizeof(key), "%p", (void *)coderef_cv);
-        SV ** entry_sv_ptr = hv_fetch(MY_CXT.callback_registry, key, strlen(key), 0);
-        if (entry_sv_ptr) {
-            Implicit_Callback_Magic * magic_data = INT2PTR(Implicit_Callback_Magic *, SvIV(*entry_sv_ptr));
-            *(void **)p = infix_reverse_get_code(magic_data->reverse_ctx);
-        }
-        else {
-            Affix_Callback_Data * cb_data;
-            Newxz(cb_data, 1, Affix_Callback_Data);
-            cb_data->coderef_rv = newRV_inc(coderef_cv);
-            storeTHX(cb_data->perl);
-            infix_type * ret_type = type->meta.func_ptr_info.return_type;
-            size_t num_args = type->meta.func_ptr_info.num_args;
-            size_t num_fixed_args = type->meta.func_ptr_info.num_fixed_args;
-            infix_type ** arg_types = NULL;
-            if (num_args > 0) {
-                Newx(arg_types, num_args, infix_type *);
-                for (size_t i = 0; i < num_args; ++i)
-                    arg_types[i] = type->meta.func_ptr_info.args[i].type;
-            }
-            infix_reverse_t * reverse_ctx = NULL;
-
-            infix_status status = infix_reverse_create_closure_manual(&reverse_ctx,
-                                                                      ret_type,
-                                                                      arg_types,
-                                                                      num_args,
-                                                                      num_fixed_args,
-                                                                      (void *)_affix_callback_handler_entry,
-                                                                      (void *)cb_data);
-            if (arg_types)
-                Safefree(arg_types);
-            if (status != INFIX_SUCCESS) {
-                SvREFCNT_dec(cb_data->coderef_rv);
-                safefree(cb_data);
-                char signature_buf[256];
-                (void)infix_type_print(
-                    signature_buf, sizeof(signature_buf), (infix_type *)type, INFIX_DIALECT_SIGNATURE);
-                croak("Failed to create callback: %s", infix_get_last_error().message);
+        // The same coderef may legitimately be handed to C under different signatures, so
+        // trampolines are looked up by (CV, signature) rather than by CV alone.
+        char signature[1024];
+        if (infix_type_print(signature, sizeof(signature), (infix_type *)type, INFIX_DIALECT_SIGNATURE) !=
+            INFIX_SUCCESS)
+            croak("Failed to create callback: signature is too long");
+        MAGIC * mg = mg_findext(coderef_cv, PERL_MAGIC_ext, &Affix_callback_vtbl);
+        if (mg) {
+            for (Implicit_Callback_Magic * entry = (Implicit_Callback_Magic *)mg->mg_ptr; entry; entry = entry->next) {
+                if (entry->reverse_ctx && strEQ(entry->signature, signature)) {
+                    *(void **)p = infix_reverse_get_code(entry->reverse_ctx);
+                    return;
+                }
             }
-            Implicit_Callback_Magic * magic_data;
-            Newxz(magic_data, 1, Implicit_Callback_Magic);
-            magic_data->reverse_ctx = reverse_ctx;
-            hv_store(MY_CXT.callback_registry, key, strlen(key), newSViv(PTR2IV(magic_data)), 0);
-            *(void **)p = infix_reverse_get_code(reverse_ctx);
         }
-    }
+        Affix_Callback_Data * cb_data;
+        Newxz(cb_data, 1, Affix_Callback_Data);
+        cb_data->cv = (CV *)coderef_cv;
+        storeTHX(cb_data->perl);
+        infix_type * ret_type = type->meta.func_ptr_info.return_type;
+        size_t num_args = type->meta.func_ptr_info.num_args;
+        size_t num_fixed_args = type->meta.func_ptr_info.num_fixed_args;
+        infix_type ** arg_types = NULL;
+        if (num_args > 0) {
+            Newx(arg_types, num_args, infix_type *);
+            for (size_t i = 0; i < num_args; ++i)
+                arg_types[i] = type->meta.func_ptr_info.args[i].type;
+        }
+        infix_reverse_t * reverse_ctx = NULL;
+
+        infix_status status = infix_reverse_create_closure_manual(&reverse_ctx,
+                                                                  ret_type,
+                                                                  arg_types,
+                                                                  num_args,
+                                                                  num_fixed_args,
+                                                                  (void *)_affix_callback_handler_entry,
+                                                                  (void *)cb_data);
+        if (arg_types)
+            Safefree(arg_types);
+        if (status != INFIX_SUCCESS) {
+            safefree(cb_data);
+            croak("Failed to create callback for %s: %s", signature, infix_get_last_error().message);
+        }
+        Implicit_Callback_Magic * entry;
+        Newxz(entry, 1, Implicit_Callback_Magic);
+        entry->reverse_ctx = reverse_ctx;
+        entry->signature = savepv(signature);
+        entry->cb_data = cb_data;
+        _attach_callback_entry(aTHX_ coderef_cv, mg, entry);
+        *(void **)p = infix_reverse_get_code(reverse_ctx);
+    }
+    else if (is_pin(aTHX_ sv))
+        *(void **)p = _get_pin_from_sv(aTHX_ sv)->pointer;
     else if (!SvOK(sv))
         *(void **)p = NULL;
     else
         croak("Argument for a callback must be a code reference or undef.");
 }
+/// @brief True for the `@Affix::UserData` marker, a `*void` that tags a user-data slot.
+static bool _is_user_data_type(const infix_type * type) {
+    if (type->category != INFIX_TYPE_POINTER)
+        return false;
+    const char * name = infix_type_get_name(type);
+    return name && strEQ(name, "Affix::UserData");
+}
+/// @brief Finds the user-data parameter of a callback signature, or -1 if it has none.
+static SSize_t _callback_user_data_slot(const infix_type * func_type) {
+    for (size_t i = 0; i < func_type->meta.func_ptr_info.num_fixed_args; ++i)
+        if (_is_user_data_type(func_type->meta.func_ptr_info.args[i].type))
+            return (SSize_t)i;
+    return -1;
+}
+/**
+ * @brief Returns the one reverse trampoline used for every coderef passed as a callback
+ *        with this signature, creating it the first time it's needed.
+ *
+ * The caller gets its own reference, dropped with _shared_callback_release().
+ */
+static Affix_Shared_Callback * _get_shared_callback(pTHX_ const infix_type * func_type, size_t user_data_index) {
+    dMY_CXT;
+    char signature[1024];
+    if (infix_type_print(signature, sizeof(signature), (infix_type *)func_type, INFIX_DIALECT_SIGNATURE) !=
+        INFIX_SUCCESS)
+        croak("Failed to create callback: signature is too long");
+    SV ** entry_sv_ptr = hv_fetch(MY_CXT.shared_callbacks, signature, strlen(signature), 0);
+    if (entry_sv_ptr) {
+        Affix_Shared_Callback * shared = INT2PTR(Affix_Shared_Callback *, SvIV(*entry_sv_ptr));
+        OP_REFCNT_LOCK;
+        shared->ref_count++;
+        OP_REFCNT_UNLOCK;
+        return shared;
+    }
+
+    Affix_Shared_Callback * shared;
+    Newxz(shared, 1, Affix_Shared_Callback);
+    shared->ref_count = 2;  // The cache's and the caller's
+    shared->user_data_index = user_data_index;
+    size_t num_args = func_type->meta.func_ptr_info.num_args;
+    infix_type ** arg_types = NULL;
+    if (num_args > 0) {
+        Newx(arg_types, num_args, infix_type *);
+        for (size_t i = 0; i < num_args; ++i)
+            arg_types[i] = func_type->meta.func_ptr_info.args[i].type;
+    }
+    infix_status status = infix_reverse_create_closure_manual(&shared->reverse_ctx,
+                                                              func_type->meta.func_ptr_info.return_type,
+                                                              arg_types,
+                                                              num_args,
+                                                              func_type->meta.func_ptr_info.num_fixed_args,
+                                                              (void *)_affix_shared_callback_handler_entry,
+                                                              (void *)shared);
+    if (arg_types)
+        Safefree(arg_types);
+    if (status != INFIX_SUCCESS) {
+        safefree(shared);
+        croak("Failed to create callback for %s: %s", signature, infix_get_last_error().message);
+    }
+    (void)hv_store(MY_CXT.shared_callbacks, signature, strlen(signature), newSViv(PTR2IV(shared)), 0);
+    return shared;
+}
+/// @brief Drops one reference on a shared trampoline, destroying it with the last one in any thread.
+static void _shared_callback_release(pTHX_ Affix_Shared_Callback * shared) {
+    OP_REFCNT_LOCK;
+    UV left = --shared->ref_count;
+    OP_REFCNT_UNLOCK;
+    if (left > 0)
+        return;
+    infix_reverse_destroy(shared->reverse_ctx);
+    safefree(shared);
+}
+/// @brief True if `held` is the user data `data_sv` names: the same referent, or an equal plain value.
+static bool _user_data_same(pTHX_ SV * held, SV * data_sv) {
+    if (SvROK(held) || SvROK(data_sv))
+        return SvROK(held) && SvROK(data_sv) && SvRV(held) == SvRV(data_sv);
+    if (!SvOK(held) || !SvOK(data_sv))
+        return !SvOK(held) && !SvOK(data_sv);
+    return sv_eq(held, data_sv);
+}
+/**
+ * @brief Returns the record passed as user data to a shared trampoline for this coderef.
+ *
+ * A coderef gets one record per distinct user data it is registered with, so C holding on
+ * to several registrations calls each back with its own. Records live on the coderef's
+ * callback magic just like per-coderef trampolines and go with it, or with release_callback().
+ */
+static Affix_Callback_Data * _get_callback_user_data(pTHX_ SV * coderef_cv, SV * data_sv) {
+    MAGIC * mg = mg_findext(coderef_cv, PERL_MAGIC_ext, &Affix_callback_vtbl);
+    if (mg) {
+        for (Implicit_Callback_Magic * entry = (Implicit_Callback_Magic *)mg->mg_ptr; entry; entry = entry->next)
+            if (!entry->reverse_ctx && _user_data_same(aTHX_ entry->cb_data->user_data, data_sv))
+                return entry->cb_data;
+    }
+    Affix_Callback_Data * cb_data;
+    Newxz(cb_data, 1, Affix_Callback_Data);
+    cb_data->cv = (CV *)coderef_cv;
+    cb_data->user_data = newSVsv(data_sv);
+    storeTHX(cb_data->perl);
+    Implicit_Callback_Magic * entry;
+    Newxz(entry, 1, Implicit_Callback_Magic);
+    entry->cb_data = cb_data;
+    _attach_callback_entry(aTHX_ coderef_cv, mg, entry);
+    return cb_data;
+}
+/**
+ * @brief Pairs callbacks that have a user-data slot with the binding's user-data arguments.
+ *
+ * The n-th such callback is paired with the n-th `@Affix::UserData` argument. Paired
+ * callbacks use a shared trampoline and the user-data argument carries the coderef.
+ */
+static void _plan_shared_callbacks(pTHX_ Affix * affix) {
+    size_t next_user_data = 0;
+    for (size_t i = 0; i < affix->num_args; ++i) {
+        const infix_type * type = affix->plan[i].data.type;
+        const infix_type * func_type = type;
+        if (type->category == INFIX_TYPE_POINTER)
+            func_type = type->meta.pointer_info.pointee_type;
+        if (func_type->category != INFIX_TYPE_REVERSE_TRAMPOLINE)
+            continue;
+        SSize_t slot = _callback_user_data_slot(func_type);
+        if (slot < 0)
+            continue;
+        while (next_user_data < affix->num_args && !_is_user_data_type(affix->plan[next_user_data].data.type))
+            next_user_data++;
+        if (next_user_data >= affix->num_args)
+            return;
+        affix->plan[i].executor = plan_step_push_shared_callback;
+        affix->plan[i].opcode = OP_PUSH_CALLBACK;
+        Affix_Shared_Callback * shared = _get_shared_callback(aTHX_ func_type, (size_t)slot);
+        affix->plan[i].data.shared_callback = shared;
+        affix->plan[i].data.shared_code = infix_reverse_get_code(shared->reverse_ctx);
+        affix->plan[next_user_data].executor = plan_step_push_user_data;
+        affix->plan[next_user_data].opcode = OP_PUSH_USER_DATA;
+        affix->plan[next_user_data].data.peer_index = i;
+        next_user_data++;
+    }
+}
 static SV * _format_parse_error(pTHX_ const char * context_msg, const char * signature, infix_error_details_t err) {
     STRLEN sig_len = strlen(signature);
     int radius = 20;
@@ -2165,6 +3738,19 @@ static SV * _format_parse_error(pTHX_ const char * context_msg, const char * sig
                                err.message,
                                err.position));
 }
+/// @brief The registry entry behind an Affix::Lib object, or NULL.
+static LibRegistryEntry * _lib_entry_from_sv(pTHX_ SV * sv) {
+    return INT2PTR(LibRegistryEntry *, SvIV((SV *)SvRV(sv)));
+}
+/// @brief Wraps an entry the caller already holds a reference on in a new Affix::Lib object.
+static SV * _new_lib_object(pTHX_ LibRegistryEntry * entry) {
+    SV * obj_data = newSViv(PTR2IV(entry));
+#ifdef USE_ITHREADS
+    MAGIC * mg = sv_magicext(obj_data, obj_data, PERL_MAGIC_ext, &Affix_lib_vtbl, NULL, 0);
+    mg->mg_flags |= MGf_DUP;
+#endif
+    return sv_bless(newRV_noinc(obj_data), gv_stashpv("Affix::Lib", GV_ADD));
+}
 XS_INTERNAL(Affix_Lib_as_string) {
     dVAR;
     dXSARGS;
@@ -2172,67 +3758,30 @@ XS_INTERNAL(Affix_Lib_as_string) {
         croak_xs_usage(cv, "$lib");
     IV RETVAL;
     {
-        infix_library_t * lib;
-        IV tmp = SvIV((SV *)SvRV(ST(0)));
-        lib = INT2PTR(infix_library_t *, tmp);
-        RETVAL = PTR2IV(lib->handle);
+        LibRegistryEntry * entry = _lib_entry_from_sv(aTHX_ ST(0));
+        RETVAL = entry ? PTR2IV(entry->lib->handle) : 0;
     }
     XSRETURN_IV(RETVAL);
 };
 XS_INTERNAL(Affix_Lib_DESTROY) {
     dXSARGS;
-    dMY_CXT;
     if (items != 1)
         croak_xs_usage(cv, "$lib");
-    IV tmp = SvIV((SV *)SvRV(ST(0)));
-    infix_library_t * lib = INT2PTR(infix_library_t *, tmp);
-    if (MY_CXT.lib_registry) {
-        hv_iterinit(MY_CXT.lib_registry);
-        HE * he;
-        while ((he = hv_iternext(MY_CXT.lib_registry))) {
-            SV * entry_sv = HeVAL(he);
-            LibRegistryEntry * entry = INT2PTR(LibRegistryEntry *, SvIV(entry_sv));
-            if (entry->lib == lib) {
-                entry->ref_count--;
-                if (entry->ref_count == 0) {
-                    infix_library_close(entry->lib);
-                    safefree(entry);
-                    hv_delete_ent(MY_CXT.lib_registry, HeKEY_sv(he), G_DISCARD, 0);
-                }
-                break;
-            }
-        }
-    }
+    SV * obj_data = SvRV(ST(0));
+    LibRegistryEntry * entry = INT2PTR(LibRegistryEntry *, SvIV(obj_data));
+    sv_setiv(obj_data, 0);
+    _lib_registry_release(aTHX_ entry);
     XSRETURN_EMPTY;
 }
 XS_INTERNAL(Affix_load_library) {
     dXSARGS;
-    dMY_CXT;
     if (items != 1)
         croak_xs_usage(cv, "library_path");
-    const char * path = SvPV_nolen(ST(0));
-    SV ** entry_sv_ptr = hv_fetch(MY_CXT.lib_registry, path, strlen(path), 0);
-    if (entry_sv_ptr) {
-        LibRegistryEntry * entry = INT2PTR(LibRegistryEntry *, SvIV(*entry_sv_ptr));
-        entry->ref_count++;
-        SV * obj_data = newSV(0);
-        sv_setiv(obj_data, PTR2IV(entry->lib));
-        ST(0) = sv_2mortal(sv_bless(newRV_inc(obj_data), gv_stashpv("Affix::Lib", GV_ADD)));
-        XSRETURN(1);
-    }
-    infix_library_t * lib = infix_library_open(path);
-    if (lib) {
-        LibRegistryEntry * new_entry;
-        Newxz(new_entry, 1, LibRegistryEntry);
-        new_entry->lib = lib;
-        new_entry->ref_count = 1;
-        hv_store(MY_CXT.lib_registry, path, strlen(path), newSViv(PTR2IV(new_entry)), 0);
-        SV * obj_data = newSV(0);
-        sv_setiv(obj_data, PTR2IV(lib));
-        ST(0) = sv_2mortal(sv_bless(newRV_inc(obj_data), gv_stashpv("Affix::Lib", GV_ADD)));
-        XSRETURN(1);
-    }
-    XSRETURN_UNDEF;
+    LibRegistryEntry * entry = _lib_registry_acquire(aTHX_ SvPV_nolen(ST(0)));
+    if (entry == NULL)
+        XSRETURN_UNDEF;
+    ST(0) = sv_2mortal(_new_lib_object(aTHX_ entry));
+    XSRETURN(1);
 }
 XS_INTERNAL(Affix_get_last_error_message) {
     dXSARGS;
@@ -2300,6 +3849,124 @@ static U32 Affix_len_pin(pTHX_ SV * sv, MAGIC * mg) {
     }
     return pin->type->size;
 }
+
+/// @brief A new, unlisted entry owning `arena` and `type`, holding the caller's reference on `inner`.
+static Affix_Type * _type_new(infix_arena_t * arena, const infix_type * type, Affix_Type * inner) {
+    Affix_Type * ref;
+    Newxz(ref, 1, Affix_Type);
+    ref->ref_count = 1;
+    ref->arena = arena;
+    ref->type = type;
+    ref->inner = inner;
+    return ref;
+}
+static void _type_release(Affix_Type * ref) {
+    while (ref != NULL && --ref->ref_count == 0) {
+        Affix_Type * inner = ref->inner;
+        if (ref->arena)
+            infix_arena_destroy(ref->arena);
+        safefree(ref);
+        ref = inner;
+    }
+}
+/// @brief Unlists the interned type graphs that only the cache still holds.
+static void _type_cache_trim(pTHX) {
+    dMY_CXT;
+    HE * he;
+    hv_iterinit(MY_CXT.type_cache);
+    while ((he = hv_iternext(MY_CXT.type_cache))) {
+        Affix_Type * ref = INT2PTR(Affix_Type *, SvIV(HeVAL(he)));
+        if (ref->ref_count > 1)
+            continue;
+        _type_release(ref);
+        hv_delete_ent(MY_CXT.type_cache, hv_iterkeysv(he), G_DISCARD, HeHASH(he));
+    }
+}
+#define AFFIX_TYPE_CACHE_IDLE 256
+/**
+ * @brief Lists `ref` in the type cache under `key`; the cache takes a reference of its own.
+ *
+ * Graphs no pin uses stay listed so a cast in a loop parses once, but only until the cache
+ * fills up. Then they are dropped, and the next trim waits until the cache has doubled.
+ */
+static void _type_cache_store(pTHX_ SV * key, Affix_Type * ref) {
+    dMY_CXT;
+    if (HvUSEDKEYS(MY_CXT.type_cache) >= MY_CXT.type_cache_trim_at) {
+        _type_cache_trim(aTHX);
+        MY_CXT.type_cache_trim_at = HvUSEDKEYS(MY_CXT.type_cache) * 2;
+        if (MY_CXT.type_cache_trim_at < AFFIX_TYPE_CACHE_IDLE)
+            MY_CXT.type_cache_trim_at = AFFIX_TYPE_CACHE_IDLE;
+    }
+    ref->ref_count++;
+    hv_store(MY_CXT.type_cache, SvPVX(key), SvCUR(key), newSViv(PTR2IV(ref)), 0);
+}
+/**
+ * @brief A reference on the interned type graph for `signature`, parsed on first use.
+ *
+ * Every pin typed with one signature shares the graph, so casting in a loop or holding
+ * millions of pins costs a hash lookup and a refcount instead of a parse and an arena each.
+ */
+static Affix_Type * _type_intern(pTHX_ const char * signature, const char * context) {
+    dMY_CXT;
+    SV * key = _signature_key(aTHX_ signature);
+    SV ** cached = hv_fetch(MY_CXT.type_cache, SvPVX(key), SvCUR(key), 0);
+    if (cached) {
+        Affix_Type * ref = INT2PTR(Affix_Type *, SvIV(*cached));
+        ref->ref_count++;
+        return ref;
+    }
+    infix_type * type = NULL;
+    infix_arena_t * arena = NULL;
+    if (infix_type_from_signature(&type, &arena, signature, MY_CXT.registry) != INFIX_SUCCESS) {
+        if (arena)
+            infix_arena_destroy(arena);
+        croak_sv(_format_parse_error(aTHX_ context, signature, infix_get_last_error()));
+    }
+    Affix_Type * ref = _type_new(arena, type, NULL);
+    _type_cache_store(aTHX_ key, ref);
+    return ref;
+}
+/// @brief `type` printed as a signature into a buffer the caller frees, or NULL if it cannot be printed.
+static char * _type_signature(const infix_type * type) {
+    for (size_t size = 256; size <= 65536; size *= 2) {
+        char * signature = (char *)safemalloc(size);
+        if (infix_type_print(signature, size, (infix_type *)type, INFIX_DIALECT_SIGNATURE) == INFIX_SUCCESS)
+            return signature;
+        safefree(signature);
+    }
+    return NULL;
+}
+/// @brief A reference on the interned graph with the same signature as `type`, which may belong to a plan.
+static Affix_Type * _type_intern_graph(pTHX_ const infix_type * type) {
+    char * signature = _type_signature(type);
+    if (signature == NULL)
+        croak("Failed to describe the type of a pin");
+    SV * holder = sv_2mortal(newSV(0));
+    sv_usepvn(holder, signature, strlen(signature));
+    return _type_intern(aTHX_ SvPVX(holder), "for pin");
+}
+/// @brief Points `pin` at the graph behind `ref`, taking over the caller's reference.
+static void _pin_set_type(Affix_Pin * pin, Affix_Type * ref) {
+    Affix_Type * old = pin->type_ref;
+    pin->type_ref = ref;
+    pin->type = ref ? ref->type : NULL;
+    _type_release(old);
+}
+/// @brief Unlists interned type graphs, all of them or only those whose signature names a type.
+static void _type_cache_drop(pTHX_ bool named_only) {
+    dMY_CXT;
+    HE * he;
+    hv_iterinit(MY_CXT.type_cache);
+    while ((he = hv_iternext(MY_CXT.type_cache))) {
+        STRLEN len;
+        const char * key = HePV(he, len);
+        if (named_only && !memchr(key, '@', len))
+            continue;
+        // Pins typed with the graph keep it alive until they are freed.
+        _type_release(INT2PTR(Affix_Type *, SvIV(HeVAL(he))));
+        hv_delete_ent(MY_CXT.type_cache, hv_iterkeysv(he), G_DISCARD, HeHASH(he));
+    }
+}
 static int Affix_free_pin(pTHX_ SV * sv, MAGIC * mg) {
     PERL_UNUSED_VAR(sv);
     Affix_Pin * pin = (Affix_Pin *)mg->mg_ptr;
@@ -2307,8 +3974,7 @@ static int Affix_free_pin(pTHX_ SV * sv, MAGIC * mg) {
         return 0;
     if (pin->managed && pin->pointer)
         safefree(pin->pointer);
-    if (pin->type_arena != NULL)
-        infix_arena_destroy(pin->type_arena);
+    _type_release(pin->type_ref);
     safefree(pin);
     mg->mg_ptr = NULL;
     return 0;
@@ -2360,9 +4026,12 @@ bool is_pin(pTHX_ SV * sv) {
         return false;
     return mg_findext(SvRV(sv), PERL_MAGIC_ext, &Affix_pin_vtbl) != NULL;
 }
-void _pin_sv(pTHX_ SV * sv, const infix_type * type, void * pointer, bool managed) {
-    if (SvREADONLY(sv))
+/// @brief Pins `sv` to `pointer`, typed with the interned graph `type`; takes over the caller's reference.
+void _pin_sv(pTHX_ SV * sv, Affix_Type * type, void * pointer, bool managed) {
+    if (SvREADONLY(sv)) {
+        _type_release(type);
         return;
+    }
     SvUPGRADE(sv, SVt_PVMG);
     MAGIC * mg = mg_findext(sv, PERL_MAGIC_ext, &Affix_pin_vtbl);
     Affix_Pin * pin;
@@ -2370,56 +4039,32 @@ void _pin_sv(pTHX_ SV * sv, const infix_type * type, void * pointer, bool manage
         pin = (Affix_Pin *)mg->mg_ptr;
         if (pin && pin->managed && pin->pointer)
             safefree(pin->pointer);
-        if (pin && pin->type_arena) {
-            infix_arena_destroy(pin->type_arena);
-            pin->type_arena = NULL;
-        }
     }
     else {
         Newxz(pin, 1, Affix_Pin);
-        mg = sv_magicext(sv, NULL, PERL_MAGIC_ext, &Affix_pin_vtbl, (const char *)pin, 0);
+        mg = _pin_magicext(aTHX_ sv, pin);
     }
     pin->pointer = pointer;
     pin->managed = managed;
-    pin->type_arena = infix_arena_create(2048);
-    if (!pin->type_arena) {
-        safefree(pin);
-        mg->mg_ptr = NULL;
-        croak("Failed to create memory arena for pin's type information");
-    }
-    pin->type = _copy_type_graph_to_arena(pin->type_arena, type);
-    if (!pin->type) {
-        infix_arena_destroy(pin->type_arena);
-        safefree(pin);
-        mg->mg_ptr = NULL;
-        croak("Failed to copy type information into pin");
-    }
+    _pin_set_type(pin, type);
 }
 XS_INTERNAL(Affix_find_symbol) {
     dXSARGS;
     if (items != 2 || !sv_isobject(ST(0)) || !sv_derived_from(ST(0), "Affix::Lib"))
         croak_xs_usage(cv, "Affix_Lib_object, symbol_name");
-    IV tmp = SvIV((SV *)SvRV(ST(0)));
-    infix_library_t * lib = INT2PTR(infix_library_t *, tmp);
+    LibRegistryEntry * entry = _lib_entry_from_sv(aTHX_ ST(0));
     const char * name = SvPV_nolen(ST(1));
-    void * symbol = infix_library_get_symbol(lib, name);
+    void * symbol = entry ? infix_library_get_symbol(entry->lib, name) : NULL;
     if (symbol) {
         Affix_Pin * pin;
         Newxz(pin, 1, Affix_Pin);
         pin->pointer = symbol;
         pin->managed = false;
-        pin->type_arena = infix_arena_create(256);
-        infix_type * void_ptr_type = NULL;
-        if (infix_type_create_pointer_to(pin->type_arena, &void_ptr_type, infix_type_create_void()) != INFIX_SUCCESS) {
-            safefree(pin);
-            infix_arena_destroy(pin->type_arena);
-            croak("Internal error: Failed to create pointer type for pin");
-        }
-        pin->type = void_ptr_type;
+        _pin_set_type(pin, _type_intern(aTHX_ "*void", "for pin"));
         SV * obj_data = newSV(0);
         sv_setiv(obj_data, PTR2IV(pin));
         SV * rv = newRV_inc(obj_data);
-        sv_magicext(obj_data, NULL, PERL_MAGIC_ext, &Affix_pin_vtbl, (const char *)pin, 0);
+        _pin_magicext(aTHX_ obj_data, pin);
         ST(0) = sv_2mortal(rv);
         XSRETURN(1);
     }
@@ -2427,7 +4072,6 @@ XS_INTERNAL(Affix_find_symbol) {
 }
 XS_INTERNAL(Affix_pin) {
     dXSARGS;
-    dMY_CXT;
     if (items != 4)
         croak_xs_usage(cv, "var, lib, symbol, type");
     SV * target_sv = ST(0);
@@ -2442,12 +4086,7 @@ XS_INTERNAL(Affix_pin) {
     infix_library_close(lib);
     if (ptr == NULL)
         croak("Failed to locate symbol '%s' in library '%s'", symbol_name, lib_path_or_name);
-    infix_type * type = NULL;
-    infix_arena_t * arena = NULL;
-    if (infix_type_from_signature(&type, &arena, signature, MY_CXT.registry) != INFIX_SUCCESS)
-        croak_sv(_format_parse_error(aTHX_ "for pin", signature, infix_get_last_error()));
-    _pin_sv(aTHX_ target_sv, type, ptr, false);
-    infix_arena_destroy(arena);
+    _pin_sv(aTHX_ target_sv, _type_intern(aTHX_ signature, "for pin"), ptr, false);
     XSRETURN_YES;
 }
 XS_INTERNAL(Affix_unpin) {
@@ -2458,6 +4097,34 @@ XS_INTERNAL(Affix_unpin) {
         XSRETURN_YES;
     XSRETURN_NO;
 }
+XS_INTERNAL(Affix_release_callback) {
+    dXSARGS;
+    if (items != 1)
+        croak_xs_usage(cv, "coderef");
+    SV * arg = ST(0);
+    if (!SvROK(arg) || SvTYPE(SvRV(arg)) != SVt_PVCV)
+        croak("Argument to release_callback must be a code reference");
+    XSRETURN_IV(_release_callback(aTHX_(CV *) SvRV(arg)));
+}
+/// @brief The number of trampolines and user-data records alive in this interpreter.
+XS_INTERNAL(Affix_live_callbacks) {
+    dXSARGS;
+    dMY_CXT;
+    if (items != 0)
+        croak_xs_usage(cv, "");
+    IV count = 0;
+    if (MY_CXT.callback_registry) {
+        HE * he;
+        hv_iterinit(MY_CXT.callback_registry);
+        while ((he = hv_iternext(MY_CXT.callback_registry))) {
+            MAGIC * mg = mg_findext(INT2PTR(SV *, SvIV(HeVAL(he))), PERL_MAGIC_ext, &Affix_callback_vtbl);
+            for (Implicit_Callback_Magic * entry = mg ? (Implicit_Callback_Magic *)mg->mg_ptr : NULL; entry;
+                 entry = entry->next)
+                count++;
+        }
+    }
+    XSRETURN_IV(count);
+}
 XS_INTERNAL(Affix_sizeof) {
     dXSARGS;
     dMY_CXT;
@@ -2486,10 +4153,13 @@ void _export_function(pTHX_ HV * _export, const char * what, const char * _tag)
         (void)hv_store(_export, _tag, strlen(_tag), newRV_noinc(MUTABLE_SV(av)), 0);
     }
 }
-void _affix_callback_handler_entry(infix_context_t * ctx, void * retval, void ** args) {
-    Affix_Callback_Data * cb_data = (Affix_Callback_Data *)infix_reverse_get_user_data(ctx);
-    if (!cb_data)
-        return;
+/**
+ * @brief Calls a Perl coderef on behalf of a reverse trampoline.
+ * @param user_data_index The argument that is the user-data slot of a shared trampoline. The
+ *        coderef's stored user data is passed in its place. Use (size_t)-1 for none.
+ */
+static void _affix_invoke_callback(
+    infix_context_t * ctx, Affix_Callback_Data * cb_data, void * retval, void ** args, size_t user_data_index) {
     dTHXa(cb_data->perl);
     dSP;
     ENTER;
@@ -2498,6 +4168,10 @@ void _affix_callback_handler_entry(infix_context_t * ctx, void * retval, void **
     size_t num_args = infix_reverse_get_num_args(ctx);
 
     for (size_t i = 0; i < num_args; ++i) {
+        if (i == user_data_index) {
+            XPUSHs(cb_data->user_data ? cb_data->user_data : &PL_sv_undef);
+            continue;
+        }
         const infix_type * type = infix_reverse_get_arg_type(ctx, i);
         Affix_Pull puller = get_pull_handler(type);
         if (!puller)
@@ -2509,7 +4183,9 @@ void _affix_callback_handler_entry(infix_context_t * ctx, void * retval, void **
     PUTBACK;
     const infix_type * ret_type = infix_reverse_get_return_type(ctx);
     U32 call_flags = G_EVAL | G_KEEPERR | ((ret_type->category == INFIX_TYPE_VOID) ? G_VOID : G_SCALAR);
-    size_t count = call_sv(cb_data->coderef_rv, call_flags);
+    cb_data->running++;
+    size_t count = call_sv((SV *)cb_data->cv, call_flags);
+    cb_data->running--;
     if (SvTRUE(ERRSV)) {
         Perl_warn(aTHX_ "Perl callback died: %" SVf, ERRSV);
         sv_setsv(ERRSV, &PL_sv_undef);
@@ -2525,6 +4201,24 @@ void _affix_callback_handler_entry(infix_context_t * ctx, void * retval, void **
     FREETMPS;
     LEAVE;
 }
+void _affix_callback_handler_entry(infix_context_t * ctx, void * retval, void ** args) {
+    Affix_Callback_Data * cb_data = (Affix_Callback_Data *)infix_reverse_get_user_data(ctx);
+    if (!cb_data)
+        return;
+    _affix_invoke_callback(ctx, cb_data, retval, args, (size_t)-1);
+}
+void _affix_shared_callback_handler_entry(infix_context_t * ctx, void * retval, void ** args) {
+    Affix_Shared_Callback * shared = (Affix_Shared_Callback *)infix_reverse_get_user_data(ctx);
+    Affix_Callback_Data * cb_data = *(Affix_Callback_Data **)args[shared->user_data_index];
+    if (!cb_data) {
+        // C handed back a NULL user-data pointer; there is nobody to dispatch to.
+        const infix_type * ret_type = infix_reverse_get_return_type(ctx);
+        if (retval && ret_type->category != INFIX_TYPE_VOID)
+            memset(retval, 0, infix_type_get_size(ret_type));
+        return;
+    }
+    _affix_invoke_callback(ctx, cb_data, retval, args, shared->user_data_index);
+}
 XS_INTERNAL(Affix_as_string) {
     dVAR;
     dXSARGS;
@@ -2551,57 +4245,95 @@ XS_INTERNAL(Affix_END) {
     dXSARGS;
     dMY_CXT;
     PERL_UNUSED_VAR(items);
+    if (MY_CXT.signature_cache) {
+        // Dropping the cached CVs runs Affix::DESTROY on each plan.
+        HV * cache = MY_CXT.signature_cache;
+        MY_CXT.signature_cache = NULL;
+        SvREFCNT_dec(cache);
+    }
+    if (MY_CXT.type_cache) {
+        _type_cache_drop(aTHX_ false);
+        hv_undef(MY_CXT.type_cache);
+        MY_CXT.type_cache = NULL;
+    }
     if (MY_CXT.lib_registry) {
+        // Entries still listed here are held by bindings or Affix::Lib objects that outlive
+        // END; each one closes its library when the last of those holders is freed.
+#if DEBUG > 0
         hv_iterinit(MY_CXT.lib_registry);
         HE * he;
         while ((he = hv_iternext(MY_CXT.lib_registry))) {
-            SV * entry_sv = HeVAL(he);
-            LibRegistryEntry * entry = INT2PTR(LibRegistryEntry *, SvIV(entry_sv));
-            if (entry) {
-#if DEBUG > 0
-                if (entry->ref_count > 0) {
-                    warn("Affix: library handle for '%s' has %d outstanding references at END.",
-                         HeKEY(he),
-                         (int)entry->ref_count);
-                }
-#endif
-                if (entry->lib)
-                    infix_library_close(entry->lib);
-                safefree(entry);
-            }
+            LibRegistryEntry * entry = INT2PTR(LibRegistryEntry *, SvIV(HeVAL(he)));
+            warn("Affix: library handle for '%s' has %d outstanding references at END.",
+                 HeKEY(he),
+                 (int)entry->ref_count);
         }
+#endif
         hv_undef(MY_CXT.lib_registry);
         MY_CXT.lib_registry = NULL;
     }
     if (MY_CXT.callback_registry) {
-        hv_iterinit(MY_CXT.callback_registry);
+        // Detach the index first so the free magic below doesn't edit the hash we are walking.
+        HV * callbacks = MY_CXT.callback_registry;
+        MY_CXT.callback_registry = NULL;
+        hv_iterinit(callbacks);
         HE * he;
-        while ((he = hv_iternext(MY_CXT.callback_registry))) {
-            SV * entry_sv = HeVAL(he);
-            Implicit_Callback_Magic * magic_data = INT2PTR(Implicit_Callback_Magic *, SvIV(entry_sv));
-            if (magic_data) {
-                infix_reverse_t * ctx = magic_data->reverse_ctx;
-                if (ctx) {
-                    Affix_Callback_Data * cb_data = (Affix_Callback_Data *)infix_reverse_get_user_data(ctx);
-                    if (cb_data) {
-                        SvREFCNT_dec(cb_data->coderef_rv);
-                        safefree(cb_data);
-                    }
-                    infix_reverse_destroy(ctx);
-                }
-                safefree(magic_data);
-            }
+        while ((he = hv_iternext(callbacks))) {
+            sv_unmagicext(INT2PTR(SV *, SvIV(HeVAL(he))), PERL_MAGIC_ext, &Affix_callback_vtbl);
         }
-        hv_undef(MY_CXT.callback_registry);
-        MY_CXT.callback_registry = NULL;
+        hv_undef(callbacks);
+    }
+    if (MY_CXT.shared_callbacks) {
+        hv_iterinit(MY_CXT.shared_callbacks);
+        HE * he;
+        while ((he = hv_iternext(MY_CXT.shared_callbacks))) {
+            // Plans still using it, perhaps in other threads, keep it alive.
+            _shared_callback_release(aTHX_ INT2PTR(Affix_Shared_Callback *, SvIV(HeVAL(he))));
+        }
+        hv_undef(MY_CXT.shared_callbacks);
+        MY_CXT.shared_callbacks = NULL;
+    }
+    if (MY_CXT.frozen) {
+        safefree(MY_CXT.frozen);
+        MY_CXT.frozen = NULL;
     }
     if (MY_CXT.registry) {
         infix_registry_destroy(MY_CXT.registry);
         MY_CXT.registry = NULL;
     }
+    if (MY_CXT.typedefs) {
+        SvREFCNT_dec(MY_CXT.typedefs);
+        MY_CXT.typedefs = NULL;
+    }
+    if (MY_CXT.typedef_index) {
+        SvREFCNT_dec(MY_CXT.typedef_index);
+        MY_CXT.typedef_index = NULL;
+    }
     XSRETURN_EMPTY;
 }
 
+/// @brief The latest definition typedef() was given for `name`, or NULL if it has none.
+static SV * _typedef_find(pTHX_ const char * name) {
+    dMY_CXT;
+    SV ** index = hv_fetch(MY_CXT.typedef_index, name, strlen(name), 0);
+    if (!index)
+        return NULL;
+    SV ** def = av_fetch(MY_CXT.typedefs, SvIV(*index), 0);
+    return def ? *def : NULL;
+}
+/// @brief Drops every cached plan whose signature names a type.
+static void _signature_cache_drop_named(pTHX) {
+    dMY_CXT;
+    HE * he;
+    hv_iterinit(MY_CXT.signature_cache);
+    while ((he = hv_iternext(MY_CXT.signature_cache))) {
+        STRLEN len;
+        const char * key = HePV(he, len);
+        // Deleting the entry just returned by hv_iternext() is safe.
+        if (memchr(key, '@', len))
+            hv_delete_ent(MY_CXT.signature_cache, hv_iterkeysv(he), G_DISCARD, HeHASH(he));
+    }
+}
 XS_INTERNAL(Affix_typedef) {
     dXSARGS;
     dMY_CXT;
@@ -2627,18 +4359,31 @@ XS_INTERNAL(Affix_typedef) {
         sv_catpv(def_sv, " = ");
         SV * type_sv = ST(1);
         // Handle both string signatures and Affix::Type objects for the type definition
-        const char * type_str = _get_string_from_type_obj(aTHX_ type_sv);
-        if (!type_str)
-            type_str = SvPV_nolen(type_sv);
-        sv_catpv(def_sv, type_str);
+        sv_catpv(def_sv, _get_string_from_type_obj(aTHX_ type_sv));
     }
     sv_catpv(def_sv, ";");
 
     // 2. Register the type definition
     // This updates the internal registry. If this is a re-definition (filling in a forward decl),
     // infix_register_types handles the update internally.
-    if (infix_register_types(MY_CXT.registry, SvPV_nolen(def_sv)) != INFIX_SUCCESS)
-        croak_sv(_format_parse_error(aTHX_ "in typedef", SvPV_nolen(def_sv), infix_get_last_error()));
+    SV * previous = _typedef_find(aTHX_ name);
+    if (MY_CXT.frozen) {
+        // A module loaded again after freeze_types() repeats its definitions; only changes are refused.
+        if (!previous || !sv_eq(previous, def_sv))
+            croak("Cannot define type '@%s': types are frozen", name);
+    }
+    else {
+        if (infix_register_types(MY_CXT.registry, SvPV_nolen(def_sv)) != INFIX_SUCCESS)
+            croak_sv(_format_parse_error(aTHX_ "in typedef", SvPV_nolen(def_sv), infix_get_last_error()));
+        av_push(MY_CXT.typedefs, newSVsv(def_sv));
+        (void)hv_store(MY_CXT.typedef_index, name, strlen(name), newSViv(av_top_index(MY_CXT.typedefs)), 0);
+        // Plans compiled against the old definition stay with the bindings that use them, but
+        // are not handed out again. The same goes for the type graphs of pins.
+        if (previous) {
+            _signature_cache_drop_named(aTHX);
+            _type_cache_drop(aTHX_ true);
+        }
+    }
 
     // 3. Install the constant subroutine in the caller's package.
     // To avoid "Constant subroutine redefined" warnings (and the confusing line number -1),
@@ -2674,34 +4419,51 @@ XS_INTERNAL(Affix_defined_types) {
     dXSARGS;
     dMY_CXT;
     PERL_UNUSED_VAR(cv);
-
-    // First pass: count the number of defined types.
-    size_t count = 0;
-    infix_registry_iterator_t it_counter = infix_registry_iterator_begin(MY_CXT.registry);
-    while (infix_registry_iterator_next(&it_counter)) {
-        // We only count types that are fully defined, not just forward-declared.
-        if (infix_registry_iterator_get_type(&it_counter))
-            count++;
-    }
-
-    if (GIMME_V == G_SCALAR) {
-        ST(0) = sv_2mortal(newSVuv(count));
+    bool want_names = GIMME_V != G_SCALAR;
+    if (MY_CXT.frozen && !want_names) {
+        ST(0) = sv_2mortal(newSVuv(MY_CXT.frozen->count));
         XSRETURN(1);
     }
-    if (count == 0)
-        XSRETURN(0);
-
-    EXTEND(SP, count);
-
-    // Second pass: push the names onto the stack.
+    // One pass, counting in scalar context and pushing names in list context.
+    SP -= items;
+    size_t count = 0;
     infix_registry_iterator_t it = infix_registry_iterator_begin(MY_CXT.registry);
     while (infix_registry_iterator_next(&it)) {
-        if (infix_registry_iterator_get_type(&it)) {
-            const char * name = infix_registry_iterator_get_name(&it);
-            PUSHs(sv_2mortal(newSVpv(name, 0)));
-        }
+        // We only count types that are fully defined, not just forward-declared.
+        if (!infix_registry_iterator_get_type(&it))
+            continue;
+        count++;
+        if (want_names)
+            mXPUSHs(newSVpv(infix_registry_iterator_get_name(&it), 0));
     }
-    XSRETURN(count);
+    if (!want_names)
+        mXPUSHs(newSVuv(count));
+    PUTBACK;
+}
+
+/**
+ * @brief Closes the type registry to new definitions.
+ *
+ * A frozen registry is never written again, so no cached plan or pin type ever has to be
+ * retired for a redefinition, and types() counts it only once. Each thread still parses
+ * against a registry of its own: infix makes no promise that one may be shared.
+ */
+XS_INTERNAL(Affix_freeze_types) {
+    dXSARGS;
+    dMY_CXT;
+    if (items != 0)
+        croak_xs_usage(cv, "");
+    if (!MY_CXT.frozen) {
+        Affix_Frozen_Types * frozen;
+        Newxz(frozen, 1, Affix_Frozen_Types);
+        infix_registry_iterator_t it = infix_registry_iterator_begin(MY_CXT.registry);
+        while (infix_registry_iterator_next(&it))
+            if (infix_registry_iterator_get_type(&it))
+                frozen->count++;
+        MY_CXT.frozen = frozen;
+    }
+    ST(0) = sv_2mortal(newSVuv(MY_CXT.frozen->count));
+    XSRETURN(1);
 }
 
 void _DumpHex(pTHX_ const void * addr, size_t len, const char * file, int line) {
@@ -2779,69 +4541,55 @@ static SV * _new_pointer_obj(pTHX_ Affix_Pin * pin) {
     SV * rv = newRV_inc(data_sv);
     sv_setiv(data_sv, PTR2IV(pin));
     SvUPGRADE(data_sv, SVt_PVMG);
-    sv_magicext(data_sv, NULL, PERL_MAGIC_ext, &Affix_pin_vtbl, (const char *)pin, 0);
+    _pin_magicext(aTHX_ data_sv, pin);
     return rv;
 }
 XS_INTERNAL(Affix_malloc) {
     dXSARGS;
-    dMY_CXT;
     if (items != 1)
         croak_xs_usage(cv, "size");
     UV size = SvUV(ST(0));
-    infix_type * type = NULL;
-    infix_arena_t * parse_arena = NULL;
-    if (infix_type_from_signature(&type, &parse_arena, "*void", MY_CXT.registry) != INFIX_SUCCESS) {
-        if (parse_arena)
-            infix_arena_destroy(parse_arena);
-        croak_sv(_format_parse_error(aTHX_ "for malloc", "*void", infix_get_last_error()));
-    }
-    if (size == 0) {
-        infix_arena_destroy(parse_arena);
+    if (size == 0)
         croak("Cannot malloc a zero-sized type");
-    }
+    Affix_Type * type = _type_intern(aTHX_ "*void", "for malloc");
     void * ptr = safemalloc(size);
     Affix_Pin * pin;
-    Newx(pin, 1, Affix_Pin);
+    Newxz(pin, 1, Affix_Pin);
     pin->size = size;
     pin->pointer = ptr;
     pin->managed = true;
-    pin->type_arena = infix_arena_create(1024);
-    pin->type = _copy_type_graph_to_arena(pin->type_arena, type);
-    infix_arena_destroy(parse_arena);
+    _pin_set_type(pin, type);
     ST(0) = sv_2mortal(_new_pointer_obj(aTHX_ pin));
     XSRETURN(1);
 }
 XS_INTERNAL(Affix_calloc) {
     dXSARGS;
-    dMY_CXT;
     if (items != 2)
         croak_xs_usage(cv, "count, type_signature");
     UV count = SvUV(ST(0));
     const char * signature = SvPV_nolen(ST(1));
-    infix_type * elem_type = NULL;
-    infix_arena_t * parse_arena = NULL;
-    if (infix_type_from_signature(&elem_type, &parse_arena, signature, MY_CXT.registry) != INFIX_SUCCESS) {
-        if (parse_arena)
-            infix_arena_destroy(parse_arena);
-        croak_sv(_format_parse_error(aTHX_ "for calloc", signature, infix_get_last_error()));
-    }
-    size_t elem_size = infix_type_get_size(elem_type);
+    Affix_Type * elem = _type_intern(aTHX_ signature, "for calloc");
+    size_t elem_size = infix_type_get_size(elem->type);
     if (elem_size == 0) {
-        infix_arena_destroy(parse_arena);
+        _type_release(elem);
         croak("Cannot calloc a zero-sized type");
     }
+    // Only the array node is private to this pin; it points into the interned element graph.
+    infix_arena_t * arena = infix_arena_create(256);
+    infix_type * array_type;
+    if (!arena || infix_type_create_array(arena, &array_type, (infix_type *)elem->type, count) != INFIX_SUCCESS) {
+        if (arena)
+            infix_arena_destroy(arena);
+        _type_release(elem);
+        croak("Failed to create array type graph.");
+    }
     void * ptr = safecalloc(count, elem_size);
     Affix_Pin * pin;
     Newxz(pin, 1, Affix_Pin);
     pin->pointer = ptr;
     pin->managed = true;
-    pin->type_arena = infix_arena_create(1024);
-    infix_type * array_type;
-    if (infix_type_create_array(pin->type_arena, &array_type, elem_type, count) != INFIX_SUCCESS)
-        croak("Failed to create array type graph.");
-    pin->type = array_type;
+    _pin_set_type(pin, _type_new(arena, array_type, elem));
     pin->size = (count * elem_size);
-    infix_arena_destroy(parse_arena);
     ST(0) = sv_2mortal(_new_pointer_obj(aTHX_ pin));
     XSRETURN(1);
 }
@@ -2880,25 +4628,13 @@ XS_INTERNAL(Affix_free) {
 }
 XS_INTERNAL(Affix_cast) {
     dXSARGS;
-    dMY_CXT;
     if (items != 2)
         croak_xs_usage(cv, "self, new_type_signature");
     Affix_Pin * pin = _get_pin_from_sv(aTHX_ ST(0));
     if (!pin)
         croak("Argument is not a pointer");
     const char * signature = SvPV_nolen(ST(1));
-    infix_type * new_type = NULL;
-    infix_arena_t * parse_arena = NULL;
-    if (infix_type_from_signature(&new_type, &parse_arena, signature, MY_CXT.registry) != INFIX_SUCCESS) {
-        if (parse_arena)
-            infix_arena_destroy(parse_arena);
-        croak_sv(_format_parse_error(aTHX_ "for cast", signature, infix_get_last_error()));
-    }
-    if (pin->type_arena)
-        infix_arena_destroy(pin->type_arena);
-    pin->type_arena = infix_arena_create(1024);
-    pin->type = _copy_type_graph_to_arena(pin->type_arena, new_type);
-    infix_arena_destroy(parse_arena);
+    _pin_set_type(pin, _type_intern(aTHX_ signature, "for cast"));
     ST(0) = ST(0);
     XSRETURN(1);
 }
@@ -2923,6 +4659,132 @@ XS_INTERNAL(Affix_dump) {
     ST(0) = ST(0);
     XSRETURN(1);
 }
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//                   C-LEVEL PARTIAL APPLICATION
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/// @brief Reverse trampoline handler: prepends the bound arguments and calls the native target.
+void _affix_bound_native_entry(infix_context_t * ctx, void * retval, void ** args) {
+    Affix_Bound_Native * bound = (Affix_Bound_Native *)infix_reverse_get_user_data(ctx);
+    void ** c_args = (void **)alloca((bound->num_args + 1) * sizeof(void *));
+    memcpy(c_args, bound->bound_args, bound->num_bound * sizeof(void *));
+    memcpy(c_args + bound->num_bound, args, (bound->num_args - bound->num_bound) * sizeof(void *));
+    bound->cif(retval, c_args);
+}
+static void _destroy_bound_native(Affix_Bound_Native * bound) {
+    if (bound->reverse_ctx)
+        infix_reverse_destroy(bound->reverse_ctx);
+    if (bound->target)
+        infix_forward_destroy(bound->target);
+    if (bound->bound_args) {
+        for (size_t i = 0; i < bound->num_bound; ++i)
+            if (bound->bound_args[i])
+                safefree(bound->bound_args[i]);
+        safefree(bound->bound_args);
+    }
+    safefree(bound);
+}
+static int Affix_free_bound_native(pTHX_ SV * sv, MAGIC * mg) {
+    PERL_UNUSED_VAR(sv);
+    if (mg->mg_ptr)
+        _destroy_bound_native((Affix_Bound_Native *)mg->mg_ptr);
+    mg->mg_ptr = NULL;
+    return 0;
+}
+#ifdef USE_ITHREADS
+/// @brief The closure stays with the thread that made it; clones see the pointer but never free it.
+static int Affix_dup_bound_native(pTHX_ MAGIC * mg, CLONE_PARAMS * param) {
+    PERL_UNUSED_VAR(param);
+    mg->mg_ptr = NULL;
+    return 0;
+}
+#endif
+static MGVTBL Affix_bound_native_vtbl = {
+    NULL, NULL, NULL, NULL, Affix_free_bound_native, NULL, AFFIX_DUP(Affix_dup_bound_native), NULL};
+/**
+ * @brief Pre-marshals one bound argument into storage owned by the binding.
+ *
+ * Strings are copied so the closure never points into a Perl buffer that may move or be freed.
+ */
+static void * _marshal_bound_arg(pTHX_ SV * sv, const infix_type * type) {
+    size_t size = infix_type_get_size(type);
+    if (type->category == INFIX_TYPE_POINTER && !SvROK(sv) && SvPOK(sv)) {
+        STRLEN len;
+        const char * str = SvPV(sv, len);
+        // [ char* ][ bytes... \0 ] in one block: the slot points at its own copy.
+        char * block = (char *)safecalloc(1, sizeof(char *) + len + 1);
+        Copy(str, block + sizeof(char *), len, char);
+        *(char **)block = block + sizeof(char *);
+        return block;
+    }
+    if (type->category == INFIX_TYPE_POINTER && SvROK(sv) && !is_pin(aTHX_ sv) && SvTYPE(SvRV(sv)) != SVt_PVCV)
+        croak("Bound pointer arguments must be pins, strings, code references or undef");
+    void * slot = safecalloc(1, size ? size : 1);
+    sv2ptr(aTHX_ NULL, sv, slot, type);
+    return slot;
+}
+XS_INTERNAL(Affix_bind_native) {
+    dXSARGS;
+    dMY_CXT;
+    if (items < 2)
+        croak_xs_usage(cv, "fn_pin, signature, ...");
+    Affix_Pin * target_pin = _get_pin_from_sv(aTHX_ ST(0));
+    if (!target_pin || !target_pin->pointer)
+        croak("bind_native expects a pin holding a native function pointer");
+    const char * signature = _get_string_from_type_obj(aTHX_ ST(1));
+
+    Affix_Bound_Native * bound;
+    Newxz(bound, 1, Affix_Bound_Native);
+    // Attach the binding to the result right away so a croak below frees it with the mortal.
+    SV * data_sv = sv_2mortal(newSV(0));
+    SvUPGRADE(data_sv, SVt_PVMG);
+    sv_magicext(data_sv, NULL, PERL_MAGIC_ext, &Affix_bound_native_vtbl, (const char *)bound, 0)->mg_flags |= MGf_DUP;
+
+    if (infix_forward_create(&bound->target, signature, target_pin->pointer, MY_CXT.registry) != INFIX_SUCCESS)
+        croak_sv(_format_parse_error(aTHX_ "for bind_native", signature, infix_get_last_error()));
+    bound->cif = infix_forward_get_code(bound->target);
+    bound->num_args = infix_forward_get_num_args(bound->target);
+    if ((size_t)(items - 2) > bound->num_args)
+        croak("bind_native: %d arguments bound but %s only takes %d",
+              (int)(items - 2),
+              signature,
+              (int)bound->num_args);
+    Newxz(bound->bound_args, items - 2 + 1, void *);
+    for (size_t i = 0; i < (size_t)(items - 2); ++i) {
+        bound->bound_args[i] = _marshal_bound_arg(aTHX_ ST(i + 2), infix_forward_get_arg_type(bound->target, i));
+        bound->num_bound++;
+    }
+
+    size_t num_free = bound->num_args - bound->num_bound;
+    infix_type ** arg_types = NULL;
+    if (num_free > 0) {
+        Newx(arg_types, num_free, infix_type *);
+        for (size_t i = 0; i < num_free; ++i)
+            arg_types[i] = (infix_type *)infix_forward_get_arg_type(bound->target, bound->num_bound + i);
+    }
+    infix_status status =
+        infix_reverse_create_closure_manual(&bound->reverse_ctx,
+                                            (infix_type *)infix_forward_get_return_type(bound->target),
+                                            arg_types,
+                                            num_free,
+                                            num_free,
+                                            (void *)_affix_bound_native_entry,
+                                            (void *)bound);
+    if (arg_types)
+        Safefree(arg_types);
+    if (status != INFIX_SUCCESS)
+        croak("Failed to create bound function for %s: %s", signature, infix_get_last_error().message);
+
+    Affix_Pin * pin;
+    Newxz(pin, 1, Affix_Pin);
+    pin->pointer = infix_reverse_get_code(bound->reverse_ctx);
+    pin->managed = false;
+    _pin_set_type(pin, _type_intern(aTHX_ "*void", "for bind"));
+    sv_setiv(data_sv, PTR2IV(pin));
+    _pin_magicext(aTHX_ data_sv, pin);
+    ST(0) = sv_2mortal(newRV_inc(data_sv));
+    XSRETURN(1);
+}
 void _populate_hv_from_c_struct(pTHX_ Affix * affix, HV * hv, const infix_type * type, void * p) {
     hv_clear(hv);
     for (size_t i = 0; i < type->meta.aggregate_info.num_members; ++i) {
@@ -2936,6 +4798,278 @@ void _populate_hv_from_c_struct(pTHX_ Affix * affix, HV * hv, const infix_type *
     }
 }
 
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//                   C API FOR OTHER XS MODULES (Affix/API.h)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static affix_binding * _api_binding_from_sv(pTHX_ SV * sub) { return (affix_binding *)_affix_from_binding(aTHX_ sub); }
+static affix_binding * _api_binding_find(pTHX_ const char * name) {
+    CV * cv = get_cv(name, 0);
+    if (cv == NULL)
+        return NULL;
+    return _api_binding_from_sv(aTHX_ sv_2mortal(newRV_inc((SV *)cv)));
+}
+static size_t _api_binding_num_args(const affix_binding * binding) { return ((const Affix *)binding)->num_args; }
+static const affix_type * _api_binding_arg_type(const affix_binding * binding, size_t index) {
+    const Affix * affix = (const Affix *)binding;
+    return index < affix->num_args ? (const affix_type *)infix_forward_get_arg_type(affix->infix, index) : NULL;
+}
+static const affix_type * _api_binding_return_type(const affix_binding * binding) {
+    return (const affix_type *)((const Affix *)binding)->ret_type;
+}
+static void _api_binding_call(const affix_binding * binding, void * ret, void ** args) {
+    const Affix * affix = (const Affix *)binding;
+    if (affix->unbound_cif)
+        affix->unbound_cif(affix->target, ret, args);
+    else
+        affix->cif(ret, args);
+}
+static affix_type_ref * _api_type_parse(pTHX_ const char * signature) {
+    return (affix_type_ref *)_type_intern(aTHX_ signature, "for the C API");
+}
+static const affix_type * _api_type_graph(const affix_type_ref * ref) {
+    return (const affix_type *)((const Affix_Type *)ref)->type;
+}
+static void _api_type_release(affix_type_ref * ref) { _type_release((Affix_Type *)ref); }
+static size_t _api_type_size(const affix_type * type) { return infix_type_get_size((const infix_type *)type); }
+static size_t _api_type_alignment(const affix_type * type) {
+    return infix_type_get_alignment((const infix_type *)type);
+}
+static void _api_sv_to_c(pTHX_ SV * sv, const affix_type * type, void * dest) {
+    sv2ptr(aTHX_ NULL, sv, dest, (const infix_type *)type);
+}
+static void _api_c_to_sv(pTHX_ const void * src, const affix_type * type, SV * sv) {
+    ptr2sv(aTHX_ NULL, (void *)src, sv, (const infix_type *)type);
+}
+/// @brief The table published in PL_modglobal. Append new entries at the end and bump AFFIX_API_VERSION.
+static const affix_api affix_api_table = {.version = AFFIX_API_VERSION,
+                                          .size = sizeof(affix_api),
+                                          .binding_find = _api_binding_find,
+                                          .binding_from_sv = _api_binding_from_sv,
+                                          .binding_num_args = _api_binding_num_args,
+                                          .binding_arg_type = _api_binding_arg_type,
+                                          .binding_return_type = _api_binding_return_type,
+                                          .binding_call = _api_binding_call,
+                                          .type_parse = _api_type_parse,
+                                          .type_graph = _api_type_graph,
+                                          .type_release = _api_type_release,
+                                          .type_size = _api_type_size,
+                                          .type_alignment = _api_type_alignment,
+                                          .sv_to_c = _api_sv_to_c,
+                                          .c_to_sv = _api_c_to_sv};
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//                   PER-THREAD STATE AND ITHREADS CLONING
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/// @brief A type registry holding only Affix's built-in types.
+static infix_registry_t * _new_type_registry(void) {
+    infix_registry_t * registry = infix_registry_create();
+    if (!registry)
+        croak("Failed to initialize the global type registry");
+    // Marker for the user-data slot of callback APIs; see _plan_shared_callbacks().
+    if (infix_register_types(registry, "@Affix::UserData = *void;") != INFIX_SUCCESS)
+        croak("Failed to register built-in types: %s", infix_get_last_error().message);
+    return registry;
+}
+/// @brief Sets up the registries every interpreter keeps for itself, except the type registry and its index.
+static void _init_thread_state(pTHX_ my_cxt_t * cxt) {
+    cxt->lib_registry = newHV();
+    cxt->callback_registry = newHV();
+    cxt->shared_callbacks = newHV();
+    cxt->signature_cache = newHV();
+    cxt->type_cache = newHV();
+    cxt->type_cache_trim_at = AFFIX_TYPE_CACHE_IDLE;
+    cxt->typedefs = newAV();
+    cxt->frozen = NULL;
+}
+
+#ifdef USE_ITHREADS
+/// @brief Reopens a library for a clone so it stays loaded for as long as the clone needs it.
+static LibRegistryEntry * _clone_lib_entry(pTHX_ const LibRegistryEntry * parent) {
+    if (parent == NULL)
+        return NULL;
+    infix_library_t * lib = infix_library_open(*parent->path ? parent->path : NULL);
+    if (lib == NULL)
+        return NULL;
+    // Private to the clone: its registry is rebuilt empty by CLONE.
+    LibRegistryEntry * entry;
+    Newxz(entry, 1, LibRegistryEntry);
+    entry->lib = lib;
+    entry->ref_count = 1;
+    entry->path = savepv(parent->path);
+    return entry;
+}
+/**
+ * @brief The binding a new ithread gets: the parent's core, with call frames of its own.
+ *
+ * The clone takes its own reference on the library and starts with an empty result cache.
+ */
+static Affix * _clone_affix(pTHX_ const Affix * parent) {
+    Affix * affix = _derive_affix(aTHX_ parent);
+    affix->target = parent->target;
+    affix->lib_entry = _clone_lib_entry(aTHX_ parent->lib_entry);
+    if (parent->memo) {
+        affix->memo = _memo_new(aTHX_ parent->memo->capacity);
+        Newx(affix->memo->string_args, affix->num_args + 1, bool);
+        Copy(parent->memo->string_args, affix->memo->string_args, affix->num_args + 1, bool);
+    }
+    return affix;
+}
+static Affix_Variadic * _clone_variadic(pTHX_ const Affix_Variadic * parent) {
+    Affix_Variadic * variadic;
+    Newx(variadic, 1, Affix_Variadic);
+    StructCopy(parent, variadic, Affix_Variadic);
+    variadic->prefix = savepvn(parent->prefix, parent->prefix_len);
+    variadic->suffix = savepv(parent->suffix);
+    variadic->lib_entry = _clone_lib_entry(aTHX_ parent->lib_entry);
+    // Shapes are plain bindings, rebuilt on demand.
+    variadic->shapes = _memo_new(aTHX_ parent->shapes->capacity);
+    return variadic;
+}
+static Affix_Backend * _clone_backend(pTHX_ const Affix_Backend * parent) {
+    Affix_Backend * backend;
+    Newx(backend, 1, Affix_Backend);
+    StructCopy(parent, backend, Affix_Backend);
+    OP_REFCNT_LOCK;
+    backend->core->ref_count++;
+    OP_REFCNT_UNLOCK;
+    Newx(backend->arg_types, parent->num_args + 1, const infix_type *);
+    Copy(parent->arg_types, backend->arg_types, parent->num_args, const infix_type *);
+    backend->lib_entry = _clone_lib_entry(aTHX_ parent->lib_entry);
+    return backend;
+}
+static Affix_Lazy * _clone_lazy(pTHX_ const Affix_Lazy * parent, CLONE_PARAMS * param) {
+    Affix_Lazy * pending;
+    Newx(pending, 1, Affix_Lazy);
+    StructCopy(parent, pending, Affix_Lazy);
+    pending->signature = savepv(parent->signature);
+    pending->symbol_name = savepv(parent->symbol_name);
+    pending->lib_entry = _clone_lib_entry(aTHX_ parent->lib_entry);
+    pending->options = (HV *)sv_dup_inc((SV *)parent->options, param);
+    return pending;
+}
+static Affix_Chain * _clone_chain(pTHX_ const Affix_Chain * parent, CLONE_PARAMS * param) {
+    Affix_Chain * chain;
+    Newxz(chain, 1, Affix_Chain);
+    Newxz(chain->stages, parent->num_stages, Affix *);
+    Newxz(chain->cvs, parent->num_stages, CV *);
+    for (size_t i = 0; i < parent->num_stages; ++i) {
+        // Cloning the stage's CV runs its own dup hook, so its plan is this thread's by now.
+        chain->cvs[i] = (CV *)sv_dup_inc((SV *)parent->cvs[i], param);
+        chain->stages[i] = (Affix *)CvXSUBANY(chain->cvs[i]).any_ptr;
+    }
+    chain->num_stages = parent->num_stages;
+    chain->max_ret_size = parent->max_ret_size;
+    return chain;
+}
+/// @brief Dup hook for binding CVs. The clone's CvXSUBANY still points at the parent's state.
+static int Affix_dup_binding(pTHX_ MAGIC * mg, CLONE_PARAMS * param) {
+    CV * cv = (CV *)mg->mg_obj;
+    if (!cv || !CvXSUBANY(cv).any_ptr)
+        return 0;
+    XSUBADDR_t xsub = CvXSUB(cv);
+    if (xsub == Affix_trigger) {
+        const Affix * parent = (const Affix *)CvXSUBANY(cv).any_ptr;
+        CvXSUBANY(cv).any_ptr = _clone_affix(aTHX_ parent);
+    }
+    else if (xsub == Affix_trigger_lazy) {
+        const Affix_Lazy * parent = (const Affix_Lazy *)CvXSUBANY(cv).any_ptr;
+        CvXSUBANY(cv).any_ptr = _clone_lazy(aTHX_ parent, param);
+    }
+    else if (xsub == Affix_trigger_variadic) {
+        const Affix_Variadic * parent = (const Affix_Variadic *)CvXSUBANY(cv).any_ptr;
+        CvXSUBANY(cv).any_ptr = _clone_variadic(aTHX_ parent);
+    }
+    else if (xsub == Affix_trigger_chain) {
+        const Affix_Chain * parent = (const Affix_Chain *)CvXSUBANY(cv).any_ptr;
+        CvXSUBANY(cv).any_ptr = _clone_chain(aTHX_ parent, param);
+    }
+    else if (xsub == Affix_trigger_backend) {
+        const Affix_Backend * parent = (const Affix_Backend *)CvXSUBANY(cv).any_ptr;
+        CvXSUBANY(cv).any_ptr = _clone_backend(aTHX_ parent);
+    }
+    return 0;
+}
+/// @brief Dup hook for the scalar inside an Affix::Lib object: the clone gets its own reference.
+static int Affix_dup_lib(pTHX_ MAGIC * mg, CLONE_PARAMS * param) {
+    PERL_UNUSED_VAR(param);
+    SV * sv = mg->mg_obj;
+    const LibRegistryEntry * parent = INT2PTR(const LibRegistryEntry *, SvIVX(sv));
+    SvIV_set(sv, PTR2IV(_clone_lib_entry(aTHX_ parent)));
+    return 0;
+}
+/**
+ * @brief Pins cloned into a new ithread are views of the parent's memory.
+ *
+ * The clone never frees the memory; the parent still owns it. Interned type graphs belong to
+ * the parent's interpreter, and the clone's cache does not exist yet, so the clone reparses the
+ * type against the parent's registry (idle while it is being cloned) into a graph of its own.
+ */
+static int Affix_dup_pin(pTHX_ MAGIC * mg, CLONE_PARAMS * param) {
+    Affix_Pin * parent = (Affix_Pin *)mg->mg_ptr;
+    if (parent == NULL)
+        return 0;
+    Affix_Pin * pin;
+    Newxz(pin, 1, Affix_Pin);
+    pin->pointer = parent->pointer;
+    pin->size = parent->size;
+    pin->ref_count = parent->ref_count;
+    pin->managed = false;
+    char * signature = parent->type ? _type_signature(parent->type) : NULL;
+    if (signature) {
+        dMY_CXT_INTERP(param->proto_perl);
+        infix_type * type = NULL;
+        infix_arena_t * arena = NULL;
+        if (infix_type_from_signature(&type, &arena, signature, MY_CXT.registry) == INFIX_SUCCESS)
+            _pin_set_type(pin, _type_new(arena, type, NULL));
+        else if (arena)
+            infix_arena_destroy(arena);
+        safefree(signature);
+    }
+    mg->mg_ptr = (char *)pin;
+    return 0;
+}
+/// @brief Trampolines call back into the interpreter that made them; a clone makes its own.
+static int Affix_dup_callbacks(pTHX_ MAGIC * mg, CLONE_PARAMS * param) {
+    PERL_UNUSED_VAR(param);
+    mg->mg_ptr = NULL;
+    return 0;
+}
+
+/**
+ * @brief Runs in each new ithread, after every binding it inherited has been cloned.
+ *
+ * The registries start over empty, except that types are redefined so inherited type
+ * names keep working. A thread started after freeze_types() is frozen as well.
+ */
+XS_INTERNAL(Affix_CLONE) {
+    dXSARGS;
+    if (items < 1 || strNE(SvPV_nolen(ST(0)), "Affix"))
+        XSRETURN_EMPTY;
+    MY_CXT_CLONE;
+    // MY_CXT is a copy of the parent's, which is suspended while we read from it.
+    AV * parent_typedefs = MY_CXT.typedefs;
+    Affix_Frozen_Types * frozen = MY_CXT.frozen;
+    MY_CXT.typedef_index = newHVhv(MY_CXT.typedef_index);
+    _init_thread_state(aTHX_ & MY_CXT);
+    MY_CXT.registry = _new_type_registry();
+    if (frozen) {
+        Newx(MY_CXT.frozen, 1, Affix_Frozen_Types);
+        *MY_CXT.frozen = *frozen;
+    }
+    for (SSize_t i = 0; i <= av_len(parent_typedefs); ++i) {
+        SV ** def = av_fetch(parent_typedefs, i, 0);
+        // Kept even if it fails, so the indices in typedef_index stay valid.
+        const char * text = def ? SvPVX_const(*def) : "";
+        if (*text && infix_register_types(MY_CXT.registry, text) != INFIX_SUCCESS)
+            warn("Affix: could not redefine type in new thread: %s", text);
+        av_push(MY_CXT.typedefs, newSVpv(text, 0));
+    }
+    XSRETURN_EMPTY;
+}
+#endif
+
 void boot_Affix(pTHX_ CV * cv) {
     dVAR;
     dXSBOOTARGSXSAPIVERCHK;
@@ -2944,18 +5078,19 @@ void boot_Affix(pTHX_ CV * cv) {
     my_perl = (PerlInterpreter *)PERL_GET_CONTEXT;
 #endif
     MY_CXT_INIT;
-    MY_CXT.lib_registry = newHV();
-    MY_CXT.callback_registry = newHV();
-    MY_CXT.registry = infix_registry_create();
-    if (!MY_CXT.registry)
-        croak("Failed to initialize the global type registry");
+    _init_thread_state(aTHX_ & MY_CXT);
+    MY_CXT.typedef_index = newHV();
+    MY_CXT.registry = _new_type_registry();
+    (void)hv_stores(PL_modglobal, AFFIX_API_KEY, newSVuv(PTR2UV(&affix_api_table)));
     {
-        cv = newXSproto_portable("Affix::affix", Affix_affix, __FILE__, "$$$;$");
+        cv = newXSproto_portable("Affix::affix", Affix_affix, __FILE__, "$$$;$$");
         XSANY.any_i32 = 0;
         export_function("Affix", "affix", "base");
-        cv = newXSproto_portable("Affix::wrap", Affix_affix, __FILE__, "$$$;$");
+        cv = newXSproto_portable("Affix::wrap", Affix_affix, __FILE__, "$$$;$$");
         XSANY.any_i32 = 1;
         export_function("Affix", "wrap", "base");
+        (void)newXSproto_portable("Affix::bind_all", Affix_bind_all, __FILE__, "$$;@");
+        export_function("Affix", "bind_all", "base");
         newXS("Affix::DESTROY", Affix_DESTROY, __FILE__);
     }
     {
@@ -2969,6 +5104,9 @@ void boot_Affix(pTHX_ CV * cv) {
     }
 
     newXS("Affix::END", Affix_END, __FILE__);
+#ifdef USE_ITHREADS
+    newXS("Affix::CLONE", Affix_CLONE, __FILE__);
+#endif
     sv_setsv(get_sv("Affix::()", TRUE), &PL_sv_yes);
     (void)newXSproto_portable("Affix::()", Affix_as_string, __FILE__, "$;@");
     newXS("Affix::load_library", Affix_load_library, __FILE__);
@@ -2982,11 +5120,31 @@ void boot_Affix(pTHX_ CV * cv) {
     export_function("Affix", "pin", "pin");
     (void)newXSproto_portable("Affix::unpin", Affix_unpin, __FILE__, "$");
     export_function("Affix", "unpin", "pin");
+    (void)newXSproto_portable("Affix::release_callback", Affix_release_callback, __FILE__, "$");
+    export_function("Affix", "release_callback", "callback");
+    (void)newXSproto_portable("Affix::live_callbacks", Affix_live_callbacks, __FILE__, "");
+    export_function("Affix", "live_callbacks", "callback");
+    (void)newXSproto_portable("Affix::bind_native", Affix_bind_native, __FILE__, "$$;@");
+    export_function("Affix", "bind_native", "native");
+    (void)newXSproto_portable("Affix::call_ptr", Affix_call_ptr, __FILE__, "$$;@");
+    export_function("Affix", "call_ptr", "native");
+    (void)newXSproto_portable("Affix::chain", Affix_chain, __FILE__, "@");
+    export_function("Affix", "chain", "base");
+    newXS("Affix::Chain::DESTROY", Affix_Chain_DESTROY, __FILE__);
+    newXS("Affix::Variadic::DESTROY", Affix_Variadic_DESTROY, __FILE__);
+    (void)newXSproto_portable("Affix::typed", Affix_typed, __FILE__, "$$");
+    export_function("Affix", "typed", "variadic");
+    (void)newXSproto_portable("Affix::memo_stats", Affix_memo_stats, __FILE__, "$");
+    export_function("Affix", "memo_stats", "memo");
+    (void)newXSproto_portable("Affix::memo_clear", Affix_memo_clear, __FILE__, "$");
+    export_function("Affix", "memo_clear", "memo");
     (void)newXSproto_portable("Affix::sizeof", Affix_sizeof, __FILE__, "$");
     export_function("Affix", "sizeof", "core");
 
     (void)newXSproto_portable("Affix::typedef", Affix_typedef, __FILE__, "$;$");
     (void)newXSproto_portable("Affix::types", Affix_defined_types, __FILE__, "");
+    (void)newXSproto_portable("Affix::freeze_types", Affix_freeze_types, __FILE__, "");
+    export_function("Affix", "freeze_types", "registry");
     export_function("Affix", "typedef", "registry");
 
     export_function("Affix", "affix", "core");
@@ -21,6 +21,7 @@
 
 #include "common/infix_internals.h"
 #include <infix/infix.h>
+#include "Affix/API.h"
 // This structure defines the thread-local storage for our module. Under ithreads,
 // each Perl thread will get its own private instance of this struct.
 typedef struct {
@@ -28,11 +29,30 @@ typedef struct {
     /// Maps library path -> LibRegistryEntry*.
     /// This prevents reloading the same .so/.dll and manages its lifecycle.
     HV * lib_registry;
-    // A per-thread hash table to cache callback trampolines, preventing re-creation and leaks.
-    // Maps the memory address of a Perl CV* to its corresponding Implicit_Callback_Magic* struct.
+    // A per-thread, pointer-keyed hash of every CV that currently owns callback trampolines.
+    // Maps the raw bytes of a CV* to the CV's address. The trampolines themselves live in free
+    // magic on the CV; this index only exists so END can reclaim what is still alive.
     HV * callback_registry;
+    // A per-thread cache of the reverse trampolines shared by every coderef passed under a
+    // callback signature with a user-data slot. Maps signature -> Affix_Shared_Callback*.
+    HV * shared_callbacks;
+    // A per-thread cache of call plans on unbound trampolines, used by call_ptr() and shared
+    // by every binding with the same signature. Maps the signature, whitespace removed (see
+    // _signature_key()), to a blessed Affix CV. Redefining a typedef drops the entries that name types.
+    HV * signature_cache;
+    // A per-thread table of interned type graphs handed out to pins. Maps a canonical signature
+    // to an Affix_Type*; each entry holds one of its references. Dropped with signature_cache.
+    HV * type_cache;
+    // Size at which type_cache next sheds the entries no pin uses any more; see _type_cache_store().
+    STRLEN type_cache_trim_at;
     /// @brief Type alias for an infix type registry. Represents a collection of named types.
     infix_registry_t * registry;
+    // Every definition passed to typedef(), in order, so a new ithread can rebuild its registry.
+    AV * typedefs;
+    // Maps each name given to typedef() to the index of its latest definition in typedefs.
+    HV * typedef_index;
+    // Set by freeze_types(); typedef() then only accepts definitions it has already seen.
+    struct Affix_Frozen_Types * frozen;
 } my_cxt_t;
 START_MY_CXT;
 // Helper macro to fetch a value from a hash if it exists, otherwise return a default.
@@ -51,6 +71,41 @@ START_MY_CXT;
 // Forward-declare the primary structures.
 typedef struct Affix Affix;
 typedef struct Affix_Backend Affix_Backend;
+typedef struct LibRegistryEntry LibRegistryEntry;
+/// @brief Return types the direct trigger stores into TARG itself, without a pull handler.
+typedef enum {
+    AFFIX_RET_OTHER = 0,
+    AFFIX_RET_VOID,
+    AFFIX_RET_BOOL,
+    AFFIX_RET_SINT8,
+    AFFIX_RET_UINT8,
+    AFFIX_RET_SINT16,
+    AFFIX_RET_UINT16,
+    AFFIX_RET_SINT32,
+    AFFIX_RET_UINT32,
+    AFFIX_RET_SINT64,
+    AFFIX_RET_UINT64,
+    AFFIX_RET_FLOAT,
+    AFFIX_RET_DOUBLE,
+} Affix_Ret_Kind;
+/// @brief What the direct-marshalling JIT is handed for each argument instead of a bare SV*.
+///
+/// The JIT passes each entry back to our marshallers untouched, so carrying the interpreter
+/// here spares them a dTHX, which is a TLS lookup per argument under MULTIPLICITY.
+typedef struct Affix_Direct_Arg {
+    SV * sv;
+    dTHXfield(perl)
+    const infix_type * type;  ///< The argument's C type.
+    /// Set by a marshaller that pointed C at `scratch`; copies the result back after the call.
+    void (*writeback)(pTHX_ struct Affix_Direct_Arg *);
+    const infix_type * pointee;  ///< What `scratch` holds, for `writeback`.
+    union {
+        int64_t i64;
+        double f64;
+        long double ld;
+        void * ptr;
+    } scratch;  ///< Storage a pointer argument can point at for the duration of the call.
+} Affix_Direct_Arg;
 typedef struct Affix_Plan_Step Affix_Plan_Step;
 typedef struct OutParamInfo OutParamInfo;
 /**
@@ -94,6 +149,9 @@ typedef struct {
     size_t index;             // Index into perl_stack_frame for args, or c_args for out-params.
     Affix_Pull pull_handler;  // Pre-resolved pull handler for the return step.
     size_t c_arg_offset;      // Pre-calculated offset into the C arguments buffer.
+    size_t peer_index;        // For a user-data argument, the index of the callback it carries.
+    void * shared_code;       // For a callback with a user-data slot, the shared trampoline.
+    struct Affix_Shared_Callback * shared_callback;  // ...and its owner, on which the plan holds a reference.
 } Affix_Step_Data;
 
 typedef enum {
@@ -117,18 +175,46 @@ typedef enum {
     OP_PUSH_ENUM,
     OP_PUSH_COMPLEX,
     OP_PUSH_VECTOR,
+    OP_PUSH_USER_DATA,
     OP_CALL,      // Markers for end of args
     OP_RET_VOID,  // Handlers for return values
     OP_RET_INT,   // Generic int return (placeholder)
     // ... add specific return ops if optimizing return path too ...
 } Affix_Opcode;
 
+/// @brief One cached result of a pure binding, linked in most-recently-used order.
+typedef struct Affix_Memo_Entry {
+    struct Affix_Memo_Entry * prev;
+    struct Affix_Memo_Entry * next;
+    SV * key;    ///< Marshalled argument bytes.
+    SV * value;  ///< Copy of the returned value.
+} Affix_Memo_Entry;
+/// @brief Bounded LRU cache of results for a binding declared with `pure => 1`.
+typedef struct {
+    HV * index;               ///< Key bytes -> Affix_Memo_Entry*.
+    Affix_Memo_Entry * head;  ///< Most recently used.
+    Affix_Memo_Entry * tail;  ///< Least recently used; evicted first.
+    size_t count;
+    size_t capacity;
+    UV hits;
+    UV misses;
+    bool * string_args;  ///< Per argument: key on the string's contents rather than its pointer.
+    SV * key;            ///< Scratch buffer holding the key of the call in progress.
+} Affix_Memo;
 /// @brief A single step in the pre-compiled execution plan.
 struct Affix_Plan_Step {
     Affix_Step_Executor executor;  // Function pointer to the executor for this step.
     Affix_Opcode opcode;           // The instruction for the VM
     Affix_Step_Data data;          // Pre-calculated data needed by the executor.
 };
+/// @brief The parts of a binding that never change once built, shared by all of its ithreads clones.
+typedef struct {
+    UV ref_count;                   ///< Bindings using this core, across all threads. Guarded by OP_REFCNT_LOCK.
+    infix_forward_t * infix;        ///< The forward trampoline.
+    Affix_Plan_Step * plan;         ///< The execution plan.
+    size_t plan_length;             ///< Steps in `plan`.
+    OutParamInfo * out_param_info;  ///< The "out" parameter plan.
+} Affix_Core;
 /// @brief Represents a forward FFI call (a Perl sub that calls a C function).
 /// This struct holds the pre-compiled execution plan and is attached to the generated XS subroutine.
 struct Affix {
@@ -136,7 +222,7 @@ struct Affix {
     infix_arena_t * args_arena;    ///< Fast memory allocator for arguments during a call.
     infix_arena_t * ret_arena;     ///< Fast memory allocator for return value during a call.
     infix_cif_func cif;            ///< A direct function pointer to the JIT-compiled trampoline code.
-    infix_library_t * lib_handle;  ///< If affix() loaded a library itself, stores the handle for cleanup.
+    LibRegistryEntry * lib_entry;  ///< The library the symbol came from, held until the binding is freed.
     SV * return_sv;                ///< Pre-allocated, reusable SV to hold the return value.
     Affix_Plan_Step * plan;        ///< The linear array of operations (the "execution plan").
     size_t plan_length;            ///< The total number of steps in the plan.
@@ -148,41 +234,117 @@ struct Affix {
     const infix_type * ret_type;
     Affix_Pull ret_pull_handler;  ///< Cached handler for marshalling the return value.
     void ** c_args;
+    infix_unbound_cif_func unbound_cif;  ///< Set instead of `cif` when the trampoline is shared by signature.
+    void * target;                       ///< Function pointer for the next call through `unbound_cif`.
+    Affix_Memo * memo;                   ///< Result cache, only for bindings declared pure.
+    Affix_Core * core;                   ///< Owner of `infix`, `plan` and `out_param_info`.
 };
+/// @brief A refcounted, immutable type graph shared by every pin that describes its memory with it.
+typedef struct Affix_Type {
+    UV ref_count;               ///< One per pin, plus one while the entry is listed in `type_cache`.
+    infix_arena_t * arena;      ///< Owns `type`.
+    const infix_type * type;    ///< The type graph itself.
+    struct Affix_Type * inner;  ///< Another entry `type` points into, held for as long as this one.
+} Affix_Type;
+/// @brief What freeze_types() recorded about the registry it closed. Each interpreter has its own.
+typedef struct Affix_Frozen_Types {
+    size_t count;  ///< Number of fully defined types, for types().
+} Affix_Frozen_Types;
 /// @brief Represents an Affix::Pin object, a blessed Perl scalar that wraps a raw C pointer.
 typedef struct {
-    void * pointer;              ///< The raw C memory address.
-    const infix_type * type;     ///< Infix's description of the data type at 'pointer'. Used for dereferencing.
-    infix_arena_t * type_arena;  ///< Memory arena that owns the 'type' structure.
-    bool managed;                ///< If true, Perl owns the 'pointer' and will safefree() it on DESTROY.
-    UV ref_count;                ///< Refcount to prevent premature freeing when SVs are copied.
-    size_t size;                 ///< Size of malloc'd void pointers.
+    void * pointer;           ///< The raw C memory address.
+    const infix_type * type;  ///< Infix's description of the data type at 'pointer'. Used for dereferencing.
+    Affix_Type * type_ref;    ///< Reference on the graph behind 'type', released with the pin.
+    bool managed;             ///< If true, Perl owns the 'pointer' and will safefree() it on DESTROY.
+    UV ref_count;             ///< Refcount to prevent premature freeing when SVs are copied.
+    size_t size;              ///< Size of malloc'd void pointers.
 } Affix_Pin;
 /// @brief Holds the necessary data for a callback, specifically the Perl subroutine to call.
 typedef struct {
-    SV * coderef_rv;  ///< A reference (RV) to the Perl coderef. We hold this to keep it alive.
-    dTHXfield(perl)   ///< The thread context in which the callback was created.
+    CV * cv;         ///< The Perl sub to call. Borrowed; the trampoline never outlives it.
+    SV * user_data;  ///< For shared trampolines, the value handed back in the user-data slot.
+    UV running;      ///< Calls into `cv` in progress, so release_callback() cannot free it under them.
+    dTHXfield(perl)  ///< The thread context in which the callback was created.
 } Affix_Callback_Data;
 /// @brief Internal struct holding the C resources that are magically attached
 ///        to a user's coderef (CV*) when it is first used as a callback.
-typedef struct {
-    infix_reverse_t * reverse_ctx;  ///< Handle to the infix reverse-call trampoline.
+///
+/// A coderef gets one of these per distinct callback signature it is passed as. They form a
+/// singly linked list hanging off the CV's free magic and are destroyed together with the CV.
+/// Entries without a trampoline are user-data records for a shared trampoline.
+typedef struct Implicit_Callback_Magic {
+    infix_reverse_t * reverse_ctx;          ///< Handle to the infix reverse-call trampoline, if any.
+    char * signature;                       ///< Canonical signature the trampoline was generated for.
+    Affix_Callback_Data * cb_data;          ///< The coderef this entry dispatches to.
+    struct Implicit_Callback_Magic * next;  ///< The next entry owned by the same CV.
 } Implicit_Callback_Magic;
-/// @brief An entry in the thread-local library registry hash.
+/// @brief A reverse trampoline shared by all coderefs passed under one callback signature.
+///
+/// The callback's user-data argument carries an Affix_Callback_Data* instead of the user's
+/// pointer, so one trampoline can dispatch to any number of coderefs. It carries no interpreter
+/// of its own, so plans cloned into other threads keep using it.
+typedef struct Affix_Shared_Callback {
+    UV ref_count;                   ///< The thread cache that made it, plus each plan using it. OP_REFCNT_LOCK.
+    infix_reverse_t * reverse_ctx;  ///< Handle to the shared reverse-call trampoline.
+    size_t user_data_index;         ///< Which callback argument is the user-data slot.
+} Affix_Shared_Callback;
+/// @brief A native function with its leading arguments bound, exposed as a plain C function pointer.
+typedef struct {
+    infix_forward_t * target;       ///< Bound forward trampoline to the native function.
+    infix_cif_func cif;             ///< Cached JIT code for `target`.
+    infix_reverse_t * reverse_ctx;  ///< The closure handed to C in place of the native function.
+    size_t num_args;                ///< Number of arguments the native function takes.
+    size_t num_bound;               ///< How many leading arguments are bound.
+    void ** bound_args;             ///< Pre-marshalled values of the bound arguments, each owned.
+} Affix_Bound_Native;
+/// @brief Bindings composed by Affix::chain(), called in order within a single XSUB.
 typedef struct {
+    Affix ** stages;      ///< Plans of the composed bindings, first to last.
+    CV ** cvs;            ///< The bindings' CVs, held so the plans outlive the chain.
+    size_t num_stages;    ///< Number of stages.
+    size_t max_ret_size;  ///< Largest return value of any stage; sizes the raw value buffers.
+} Affix_Chain;
+/// @brief A variadic function bound without a fixed shape; see Affix_trigger_variadic().
+typedef struct {
+    void * symbol;                 ///< The native function.
+    char * prefix;                 ///< Signature text up to the `;`, e.g. `(*char`.
+    STRLEN prefix_len;             ///< Length of `prefix`.
+    char * suffix;                 ///< Signature text from the closing parenthesis on, e.g. `) -> int`.
+    size_t num_fixed;              ///< Number of fixed arguments.
+    LibRegistryEntry * lib_entry;  ///< The library the symbol came from, held until the binding is freed.
+    Affix_Memo * shapes;           ///< Concrete signature -> blessed Affix CV for that shape.
+} Affix_Variadic;
+/// @brief A binding declared lazy that has not been called yet; see Affix_trigger_lazy().
+typedef struct {
+    char * signature;              ///< Compiled on the first call.
+    char * symbol_name;            ///< Looked up in `lib_entry` on the first call.
+    void * symbol;                 ///< The native function, if the target was a pin.
+    LibRegistryEntry * lib_entry;  ///< The library to resolve from, handed on to the real binding.
+    HV * options;                  ///< Binding options, applied on the first call.
+} Affix_Lazy;
+/// @brief An entry in the thread-local library registry hash.
+///
+/// Bindings and Affix::Lib objects point straight at their entry, so releasing one never
+/// searches the registry.
+struct LibRegistryEntry {
     infix_library_t * lib;  ///< The handle to the opened library.
     UV ref_count;           ///< Reference count. The library is closed only when this reaches 0.
-} LibRegistryEntry;
+    char * path;            ///< The entry's key in the registry ("" for the program itself).
+};
 
 // Struct for the Direct Marshalling (aka "bundle") backend.
 /// @brief Represents a forward FFI call created with the high-performance direct marshalling API.
 struct Affix_Backend {
-    infix_forward_t * infix;       ///< Handle to the infix trampoline and type info.
-    infix_direct_cif_func cif;     ///< Direct pointer to the specialized JIT code.
-    infix_library_t * lib_handle;  ///< Handle for library cleanup.
-    const infix_type * ret_type;   ///< Cached return type info.
-    Affix_Pull pull_handler;       ///< Pre-resolved handler for marshalling the return value.
-    size_t num_args;               ///< Cached number of arguments.
+    infix_forward_t * infix;        ///< Handle to the infix trampoline and type info.
+    infix_direct_cif_func cif;      ///< Direct pointer to the specialized JIT code.
+    LibRegistryEntry * lib_entry;   ///< The library the symbol came from, held until the binding is freed.
+    const infix_type * ret_type;    ///< Cached return type info.
+    Affix_Pull pull_handler;        ///< Pre-resolved handler for marshalling the return value.
+    size_t num_args;                ///< Cached number of arguments.
+    const infix_type ** arg_types;  ///< Cached argument types, handed to the marshallers.
+    bool has_pointer_args;          ///< If false, no argument can need a writeback.
+    Affix_Ret_Kind ret_kind;        ///< How the trigger stores the result into TARG.
+    Affix_Core * core;              ///< Owner of `infix`, shared with ithreads clones.
 };
 
 // Trigger function for the new backend.
@@ -198,8 +360,10 @@ extern void Affix_trigger(pTHX_ CV *);
 // Marshalling (Perl -> C)
 void sv2ptr(pTHX_ Affix * affix, SV * perl_sv, void * c_ptr, const infix_type * type);
 void push_struct(pTHX_ Affix * affix, const infix_type * type, SV * sv, void * p);
+void push_union(pTHX_ Affix * affix, const infix_type * type, SV * sv, void * p);
 void push_array(pTHX_ Affix * affix, const infix_type * type, SV * sv, void * p);
 void push_reverse_trampoline(pTHX_ Affix * affix, const infix_type * type, SV * sv, void * p);
+IV _release_callback(pTHX_ CV * cv);
 
 // Marshalling (C -> Perl)
 void ptr2sv(pTHX_ Affix * affix, void * c_ptr, SV * perl_sv, const infix_type * type);
@@ -211,12 +375,14 @@ Affix_Pull get_pull_handler(const infix_type * type);
 Affix_Out_Param_Writer get_out_param_writer(const infix_type * type);
 
 // Pin (Pointer Object) Management
-void _pin_sv(pTHX_ SV * sv, const infix_type * type, void * pointer, bool managed);
+void _pin_sv(pTHX_ SV * sv, Affix_Type * type, void * pointer, bool managed);
 bool is_pin(pTHX_ SV * sv);
 Affix_Pin * _get_pin_from_sv(pTHX_ SV * sv);
 
 // Reverse FFI (Callback)
 void _affix_callback_handler_entry(infix_context_t *, void *, void **);
+void _affix_shared_callback_handler_entry(infix_context_t *, void *, void **);
+void _affix_bound_native_entry(infix_context_t *, void *, void **);
 
 // Misc Internals & Helpers
 void _export_function(pTHX_ HV *, const char *, const char *);
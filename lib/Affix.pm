@@ -11,9 +11,8 @@ package Affix 1.00 {    # 'FFI' is my middle name!
     no warnings qw[experimental::class experimental::try];
     use Carp                  qw[];
     use Config                qw[%Config];
-    use File::Spec::Functions qw[rel2abs canonpath curdir path catdir];
+    use File::Spec::Functions qw[rel2abs canonpath curdir path catdir catfile];
     use File::Basename        qw[basename dirname];
-    use File::Find            qw[find];
     use File::Temp            qw[tempdir];
     #
     my $okay = 0;
@@ -60,7 +59,7 @@ package Affix 1.00 {    # 'FFI' is my middle name!
             String WString
             Pointer Array Struct Union Enum Callback CodeRef Complex Vector
             Packed VarArgs
-            SV
+            SV UserData
             M256 M256d M512 M512d M512i
         ]
     ];
@@ -85,20 +84,95 @@ package Affix 1.00 {    # 'FFI' is my middle name!
     my $is_bsd = $OS =~ /bsd/;
     my $is_sun = $OS =~ /(solaris|sunos)/;
     #
-    sub locate_libs ( $lib, $version ) {
+    # Where Affix keeps files it can always rebuild. Opt-in: undef unless $ENV{AFFIX_CACHE_DIR} names a writable directory.
+    sub _cache_dir() {
+        my $dir = $ENV{AFFIX_CACHE_DIR};
+        return undef unless defined $dir && length $dir;
+        require File::Path;
+        eval { File::Path::make_path($dir) } unless -d $dir;
+        -d $dir && -w _ ? $dir : undef;
+    }
+
+    # ELF class, byte order and machine of a file, or undef if it isn't ELF.
+    sub _elf_id ($path) {
+        open my $fh, '<:raw', $path or return;
+        read( $fh, my $header, 20 ) == 20 or return;
+        substr( $header, 0, 4 ) eq "\x7fELF" or return;
+        my ( $class, $data ) = unpack 'C C', substr $header, 4, 2;
+        join ':', $class, $data, unpack $data == 1 ? 'v' : 'n', substr $header, 18, 2;
+    }
+
+    # Shared objects built for another ABI (i386 libraries on an x86_64 host, say) are skipped.
+    sub _loadable ($path) {
+        -B $path or return;
+        CORE::state $perl = _elf_id($^X) // '';
+        return 1 unless length $perl;
+        my $id = _elf_id($path);
+        !defined $id || $id eq $perl;
+    }
+
+    # glibc's list of installed libraries; see Affix::Platform::Unix::_ld_so_cache()
+    my $ld_so_cache = $OS eq 'linux' && -r '/etc/ld.so.cache' ? '/etc/ld.so.cache' : undef;
+
+    # Directories relative to the working directory. locate_libs() lists them on each lookup; they are never part of
+    # the persisted index, and find_library() never searches them.
+    my @local_libdirs = qw[. ./lib];
+
+    # The index is only valid for the directories it lists, as they were when it was built.
+    sub _library_stamp ( $dirs, $regex, $ld_cache = $ld_so_cache ) {
+        join "\0", 1, "$regex", map { $_ . '=' . ( ( stat $_ )[9] // -1 ) } grep {defined} $ld_cache, @$dirs;
+    }
+
+    # name => [ { name, version, path }, ... ], with ld.so.cache entries ahead of directory listings.
+    sub _scan_libraries ( $dirs, $regex, $ld_cache = $ld_so_cache ) {
+        my ( %libs, %seen );
+        my @paths;
+        if ( defined $ld_cache ) {
+            require Affix::Platform::Unix;
+            @paths = Affix::Platform::Unix::_ld_so_cache($ld_cache);
+        }
+        for my $dir (@$dirs) {
+            opendir my $dh, $dir or next;
+            push @paths, map { catfile( $dir, $_ ) } sort grep { !/^\./ } readdir $dh;
+        }
+        for my $path (@paths) {
+            next if $seen{ canonpath $path }++;
+            basename($path) =~ $regex or next;
+            push @{ $libs{ $+{name} } }, { %+, path => $path };
+        }
+        \%libs;
+    }
+
+    # Loads the index persisted by an earlier run, rebuilding it if any directory changed since.
+    sub _library_index ( $dirs, $regex, $file = undef ) {
+        require Storable;
+        my $stamp = _library_stamp( $dirs, $regex );
+        if ( !defined $file ) {
+            my $cache = _cache_dir();
+            $file = catfile( $cache, 'libraries-' . $Config{archname} . '.idx' ) if defined $cache;
+        }
+        if ( defined $file && -f $file ) {
+            my $index = eval { Storable::retrieve($file) };
+            return $index if $index && ref $index eq 'HASH' && ( $index->{stamp} // '' ) eq $stamp;
+        }
+        my $index = { stamp => $stamp, libs => _scan_libraries( $dirs, $regex ) };
+        if ( defined $file ) {
+            my $tmp = $file . '.' . $$;
+            eval { Storable::nstore( $index, $tmp ); rename $tmp, $file } or unlink $tmp;
+        }
+        $index;
+    }
+
+    sub locate_libs ( $lib, $version ) { _locate_libs( $lib, $version, 1 ) }
+
+    # Installed libraries only, unless $local: then those in the working directory follow them.
+    sub _locate_libs ( $lib, $version, $local ) {
         $lib =~ s[^lib][];
         my $ver;
         if ( defined $version ) {
             require version;
             $ver = version->parse($version);
         }
-
-        #~ warn $lib;
-        #~ warn $version;
-        #~ warn "Win: $is_win";
-        #~ warn "Mac: $is_mac";
-        #~ warn "BSD: $is_bsd";
-        #~ warn "Sun: $is_sun";
         CORE::state $libdirs;
         if ( !defined $libdirs ) {
             if ($is_win) {
@@ -108,15 +182,15 @@ package Affix 1.00 {    # 'FFI' is my middle name!
             else {
                 $libdirs = [
                     ( split ' ', $Config{libsdirs} ),
-                    map { warn $ENV{$_}; split /[:;]/, ( $ENV{$_} ) }
-                        grep { $ENV{$_} } qw[LD_LIBRARY_PATH DYLD_LIBRARY_PATH DYLD_FALLBACK_LIBRARY_PATH]
+                    map { split /[:;]/, ( $ENV{$_} ) } grep { $ENV{$_} } qw[LD_LIBRARY_PATH DYLD_LIBRARY_PATH DYLD_FALLBACK_LIBRARY_PATH]
                 ];
             }
             no warnings qw[once];
             require DynaLoader;
+            my %seen;
             $libdirs = [
-                grep { -d $_ } map { rel2abs($_) } qw[. ./lib ~/lib /usr/local/lib /usr/lib /lib /usr/lib/system], @DynaLoader::dl_library_path,
-                @$libdirs
+                grep { -d $_ && !$seen{$_}++ } ( defined $ENV{HOME} ? catdir( $ENV{HOME}, 'lib' ) : () ),
+                qw[/usr/local/lib /usr/lib /lib /usr/lib/system], @DynaLoader::dl_library_path, @$libdirs
             ];
         }
         CORE::state $regex;
@@ -139,50 +213,32 @@ package Affix 1.00 {    # 'FFI' is my middle name!
         (?:\.(?<version>[0-9]+(?:\.[0-9]+)*))?
         $/x;
         }
-        my %store;
-
-        #~ warn join ', ', @$libdirs;
-        my %_seen;
-        find(
-            0 ?
-                sub {    # This is rather slow...
-                warn $File::Find::name;
-                return if $store{ basename $File::Find::name };
-
-                #~ return if $_seen{basename $File::Find::name}++;
-                return if !-e $File::Find::name;
-                warn basename $File::Find::name;
-                warn;
-                $File::Find::prune = 1 if !grep { canonpath $_ eq canonpath $File::Find::name } @$libdirs;
-                /$regex/ or return;
-                warn;
-                $+{name} eq $lib or return;
-                warn;
-                my $lib_ver;
-                $lib_ver = version->parse( $+{version} ) if defined $+{version};
-                $store{ canonpath $File::Find::name } = { %+, path => $File::Find::name, ( defined $lib_ver ? ( version => $lib_ver ) : () ) }
-                    if ( defined($ver) && defined($lib_ver) ? $lib_ver == $ver : 1 );
-                } :
-                sub {
-                $File::Find::prune = 1 if !grep { canonpath $_ eq canonpath $File::Find::name } @$libdirs;
-
-                #~ return                 if -d $_;
-                return unless $_ =~ $regex;
-                return unless defined $+{name};
-                return unless $+{name} eq $lib;
-                return unless -B $File::Find::name;
-                my $lib_ver;
-                $lib_ver = version->parse( $+{version} ) if defined $+{version};
-                return unless ( defined $lib_ver && defined($ver) ? $ver == $lib_ver : 1 );
-
-                #~ use Data::Dump;
-                #~ warn $File::Find::name;
-                #~ ddx %+;
-                $store{ canonpath $File::Find::name } //= { %+, path => $File::Find::name, ( defined $lib_ver ? ( version => $lib_ver ) : () ) };
-                },
-            @$libdirs
-        );
-        values %store;
+
+        # A miss only costs a stat of each directory, unless one of them changed.
+        CORE::state $index;
+        $index = _library_index( $libdirs, $regex )
+            if !defined $index || ( !$index->{libs}{$lib} && $index->{stamp} ne _library_stamp( $libdirs, $regex ) );
+        my @candidates = @{ $index->{libs}{$lib} // [] };
+        if ($local) {
+            CORE::state $nearby;
+            my $dirs  = [ grep { -d $_ } map { rel2abs($_) } @local_libdirs ];
+            my $stamp = _library_stamp( $dirs, $regex, undef );
+            $nearby = { stamp => $stamp, libs => _scan_libraries( $dirs, $regex, undef ) } if !$nearby || $nearby->{stamp} ne $stamp;
+            my %seen = map { canonpath( $_->{path} ) => 1 } @candidates;
+            push @candidates, grep { !$seen{ canonpath $_->{path} } } @{ $nearby->{libs}{$lib} // [] };
+        }
+        my @found;
+        for my $found (@candidates) {
+            my $lib_ver;
+            if ( defined $found->{version} ) {
+                require version;
+                $lib_ver = version->parse( $found->{version} );
+            }
+            next unless ( defined $lib_ver && defined($ver) ? $ver == $lib_ver : 1 );
+            next unless _loadable( $found->{path} );
+            push @found, { %$found, ( defined $lib_ver ? ( version => $lib_ver ) : () ) };
+        }
+        @found;
     }
 
     sub locate_lib( $name, $version ) {
@@ -344,6 +400,9 @@ package Affix 1.00 {    # 'FFI' is my middle name!
     sub WString () {'*ushort'}
     sub SV()       {'SV'}
 
+    # Marks the void* user-data slot of a callback API; see _plan_shared_callbacks() in Affix.c
+    sub UserData() {'@Affix::UserData'}
+
     # Helper for Struct/Union to handle "Name => Type" syntax
     sub _build_aggregate {
         my ( $args, $wrapper ) = @_;
@@ -365,334 +424,6 @@ package Affix 1.00 {    # 'FFI' is my middle name!
         my $content = join( ',', @parts );
         return sprintf( $wrapper, $content );
     }
-
-    # Demo lib builder
-    {
-
-        class Affix::Compiler {
-            use Config     qw[%Config];
-            use Path::Tiny qw[path tempdir];
-            use File::Spec;
-            use ExtUtils::MakeMaker;
-            #
-            field $os        : param : reader //= $^O;
-            field $cleanup   : param : reader //= 0;
-            field $version   : param : reader //= ();
-            field $build_dir : param : reader //= tempdir( CLEANUP => $cleanup );
-            field $name      : param : reader;
-            field $libname : reader
-                = $build_dir->child( ( ( $os eq 'MSWin32' || $name =~ /^lib/ ) ? '' : 'lib' ) .
-                    $name . '.' .
-                    $Config{so} .
-                    ( $os eq 'MSWin32' || !defined $version ? '' : '.' . $version ) )->absolute;
-            field $platform : reader = ();    # ADJUST
-            field $source   : param : reader;
-            field $flags    : param : reader //= {
-
-                #~ ldflags => $Config{ldflags},
-                cflags   => $Config{cflags},
-                cppflags => $Config{cxxflags}
-            };
-            field @objs : reader = [];
-            ADJUST {
-                $source = [ map { _filemap($_) } @$source ];
-            }
-            #
-            sub _can_run(@cmd) {
-                state $paths //= [ map { $_->realpath } grep { $_->exists } map { path($_) } File::Spec->path ];
-                for my $exe (@cmd) {
-                    grep { return path($_) if $_ = MM->maybe_command($_) } $exe, map { $_->child($exe) } @$paths;
-                }
-            }
-            #
-            field $linker : reader : param //= _can_run qw[g++ ld];
-
-            #~ https://gcc.gnu.org/onlinedocs/gcc-3.4.0/gnat_ug_unx/Creating-an-Ada-Library.html
-            field $ada : reader : param //= _can_run qw[gnatmake];
-
-            #~ https://fasterthanli.me/series/making-our-own-executable-packer/part-5
-            #~ https://stackoverflow.com/questions/71704813/writing-and-linking-shared-libraries-in-assembly-32-bit
-            #~ https://github.com/therealdreg/nasm_linux_x86_64_pure_sharedlib
-            field $asm : reader : param //= _can_run qw[nasm as];
-            field $c   : reader : param //= _can_run qw[gcc clang cc icc icpx cl eccp];
-            field $cpp : reader : param //= _can_run qw[g++ clang++ c++ icpc icpx cl eccp];
-
-            #~ https://c3-lang.org/build-your-project/build-commands/
-            field $c3 : reader : param //= _can_run qw[c3c];
-
-            #~ https://www.circle-lang.org/site/index.html
-            field $circle : reader : param //= _can_run qw[circle];
-
-            #~ https://mazeez.dev/posts/writing-native-libraries-in-csharp
-            #~ https://medium.com/@sixpeteunder/how-to-build-a-shared-library-in-c-sharp-and-call-it-from-java-code-6931260d01e5
-            field $csharp : reader : param //= _can_run qw[dotnet];
-
-            # cobc: https://gnucobol.sourceforge.io/
-            field $cobol : reader : param //= _can_run qw[cobc cobol cob cob2];
-
-            #~ https://github.com/crystal-lang/crystal/issues/921#issuecomment-2413541412
-            field $crystal : reader : param //= _can_run qw[crystal];
-
-            #~ https://wiki.liberty-eiffel.org/index.php/Compile
-            #~ https://svn.eiffel.com/eiffelstudio-public/branches/Eiffel_54/Delivery/docs/papers/dll.html
-            field $eiffel : reader : param //= _can_run qw[se];
-
-            #~ https://dlang.org/articles/dll-linux.html#dso9
-            #~ dmd -c dll.d -fPIC
-            #~ dmd -oflibdll.so dll.o -shared -defaultlib=libphobos2.so -L-rpath=/path/to/where/shared/library/is
-            field $d       : reader : param //= _can_run qw[dmd];
-            field $fortran : reader : param //= _can_run qw[gfortran ifx ifort];
-
-            #~ https://github.com/secana/Native-FSharp-Library
-            #~ https://secanablog.wordpress.com/2020/02/01/writing-a-native-library-in-f-which-can-be-called-from-c/
-            field $fsharp : reader : param //= _can_run qw[dotnet];
-
-            #~ https://futhark.readthedocs.io/en/stable/usage.html
-            field $futhark : reader : param //= _can_run qw[futhark];    # .fut => .c
-
-            #~ https://medium.com/@walkert/fun-building-shared-libraries-in-go-639500a6a669
-            #~ https://github.com/vladimirvivien/go-cshared-examples
-            field $go : reader : param //= _can_run qw[go];
-
-            #~ https://github.com/bennoleslie/haskell-shared-example
-            #~ https://www.hobson.space/posts/haskell-foreign-library/
-            field $haskell : reader : param //= _can_run qw[ghc cabal];
-
-            #~ https://peterme.net/dynamic-libraries-in-nim.html
-            field $nim : reader : param //= _can_run qw[nim];    # .nim => .c
-
-            #~ https://odin-lang.org/news/calling-odin-from-python/
-            field $odin : reader : param //= _can_run qw[odin];
-
-            #~ https://p-org.github.io/P/getstarted/install/#step-4-recommended-ide-optional
-            #~ https://p-org.github.io/P/getstarted/usingP/#compiling-a-p-program
-            field $p : reader : param //= _can_run qw[p];    # .p => C#
-
-            #~ https://blog.asleson.org/2021/02/23/how-to-writing-a-c-shared-library-in-rust/
-            field $rust : reader : param //= _can_run qw[cargo];
-
-            #~ swiftc point.swift -emit-module -emit-library
-            #~ https://forums.swift.org/t/creating-a-c-accessible-shared-library-in-swift/45329/5
-            #~ https://theswiftdev.com/building-static-and-dynamic-swift-libraries-using-the-swift-compiler/#should-i-choose-dynamic-or-static-linking
-            field $swift : reader : param //= _can_run qw[swiftc];
-
-            #~ https://www.rangakrish.com/index.php/2023/04/02/building-v-language-dll/
-            #~ https://dev.to/piterweb/how-to-create-and-use-dlls-on-vlang-1p13
-            field $v : reader : param //= _can_run qw[v];
-
-            #~ https://ziglang.org/documentation/0.13.0/#Exporting-a-C-Library
-            #~ zig build-lib mathtest.zig -dynamic
-            field $zig : reader : param //= _can_run qw[zig];
-            #
-            ADJUST {
-            }
-
-            sub _filemap( $file, $language //= () ) {
-                #
-                ($_) = $file =~ m[\.(?=[^.]*\z)([^.]+)\z]i;
-                $language //=                                                     #
-                    /^(?:ada|adb|ads|ali)$/i                  ? 'Ada' :           #
-                    /^(?:asm|s|a)$/i                          ? 'Assembly' :      #
-                    /^(?:c(?:c|pp|xx))$/i                     ? 'CPP' :           #
-                    /^c$/i                                    ? 'C' :             #
-                    /^c3$/i                                   ? 'C3' :            #
-                    /^d$/i                                    ? 'D' :             #
-                    /^cobol$/i                                ? 'Cobol' :         #
-                    /^csharp$/i                               ? 'CSharp' :        #
-                    /^crystal$/i                              ? 'Crystal' :       #
-                    /^futhark$/i                              ? 'Futhark' :       #
-                    /^go$/i                                   ? 'Go' :            #
-                    /^haskell$/i                              ? 'Haskell' :       #
-                    /^nim$/i                                  ? 'Nim' :           #
-                    /^odin$/i                                 ? 'Odin' :          #
-                    /^ace$/i                                  ? 'Eiffel' :        #
-                    /^(?:f(?:or)?|f(?:77|90|95|0[38]|18)?)$/i ? 'Fortran' :       #
-                    /^m+$/i                                   ? 'ObjectiveC' :    #
-                    /^p$/i                                    ? 'P' :             #
-                    /^v$/i                                    ? 'VLang' :         #
-                    ();
-                ( 'Affix::Compiler::File::' . ${language} )->new( path => $file );
-            }
-            #
-            method compile() {
-                @objs = grep {defined} map { $_->compile($flags) } @$source;
-            }
-
-            method link() {
-                return () unless grep { $_->exists } @objs;
-                system( $linker, $flags->{ldflags} // (), '-shared', '-o', $libname->stringify, ( map { $_->absolute->stringify } @objs ) ) ? () :
-                    $libname;
-            }
-
-            #~ field $cxx;
-            #~ field $d;
-            #~ field $crystal;
-        };
-
-        class Affix::Compiler::File {
-            use Config     qw[%Config];
-            use Path::Tiny qw[];
-            field $path  : reader : param;
-            field $flags : reader : param //= ();
-            field $obj   : reader : param //= ();
-            ADJUST {
-                $path = Path::Tiny::path($path) unless builtin::blessed $path;
-                $obj //= $path->sibling( $path->basename(qr/\..+?$/) . $Config{_o} );
-            }
-            method compile() {...}
-        }
-
-        class Affix::Compiler::File::CPP : isa(Affix::Compiler::File) {
-
-            # https://learn.microsoft.com/en-us/cpp
-            # https://gcc.gnu.org/
-            # https://clang.llvm.org/
-            #~ https://www.intel.com/content/www/us/en/developer/tools/oneapi/dpc-compiler.html
-            #~ https://www.ibm.com/products/c-and-c-plus-plus-compiler-family
-            #~ https://docs.oracle.com/cd/E37069_01/html/E37073/gkobs.html
-            #~ https://www.edg.com/c
-            #~ https://www.circle-lang.org/site/index.html
-            field $compiler : reader : param //= Affix::Compiler::_can_run qw[g++]
-
-                #~ clang++ cl icpx ibm-clang++ CC eccp circle]
-                ;
-
-            method compile($flags) {
-                system( $compiler, '-g', '-c', '-fPIC', $flags->{cxxflags} // (), $self->path, '-o', $self->obj ) ? () : $self->obj;
-            }
-        }
-
-        class Affix::Compiler::File::C : isa(Affix::Compiler::File) {
-            use Config qw[%Config];
-            field $compiler : reader : param //= Affix::Compiler::_can_run $Config{cc}, qw[gcc]
-
-                #~ clang cl icx ibm-clang CC eccp circle]
-                ;
-
-            method compile($flags) {
-                system( $compiler, '-g', '-c', '-Wall', '-fPIC', $flags->{cflags} // (), $self->path, '-o', $self->obj ) ? () : $self->obj;
-            }
-        }
-
-        class Affix::Compiler::File::Fortran : isa(Affix::Compiler::File) {
-
-            # GNU, Intel, Intel Classic
-            my $compiler = Affix::Compiler::_can_run qw[gfortran ifx ifort];
-
-            method compile($flags) {
-                my $obj = $self->obj;
-                my $src = $self->path;
-                warn qq`gfortran -shared -o $obj $src`;
-                `gfortran -shared -o $obj $src`;
-                $obj;
-
-             #~ $self->obj
-             #~ unless system grep {defined} $compiler, '-shared', ( Affix::Platform::Windows() ? () : '-fPIC' ), $flags->{fflags} // (), $self->path,
-             #~ '-o', $self->obj;
-            }
-        }
-
-        class Affix::Compiler::File::D : isa(Affix::Compiler::File) {
-            use Config qw[%Config];
-            field $compiler : reader : param //= Affix::Compiler::_can_run qw[dmd];
-
-            method compile($flags) {
-                system( $compiler, '-c', ( Affix::Platform::Windows() ? () : '-fPIC' ), $flags->{dflags} // (), $self->path, '-of=' . $self->obj ) ?
-                    () : $self->obj;
-            }
-        }
-
-        class Affix::Compiler::FortranXXXXXX : isa(Affix::Compiler) {
-            use Config     qw[%Config];
-            use IPC::Cmd   qw[can_run];
-            use Path::Tiny qw[path];
-            field $exe      : reader;
-            field $compiler : reader;
-            field $linker   : reader;
-            #
-            ADJUST {
-                if ( $exe = can_run('gfortran') ) {
-                    $compiler = method( $file, $obj, $flags ) {
-                        system $self->exe, qw[-c -fPIC], $file;
-                        die "failed to execute: $!\n"                                                                           if $? == -1;
-                        die sprintf "child died with signal %d, %s coredump\n", ( $? & 127 ), ( $? & 128 ) ? 'with' : 'without' if $? & 127;
-                        $obj
-                    };
-                    $linker = method($objs) {
-                        system $self->exe, qw[-shared], ( map { $_->stringify } @$objs ), '-o blah.so';
-                        die "failed to execute: $!\n"                                                                           if $? == -1;
-                        die sprintf "child died with signal %d, %s coredump\n", ( $? & 127 ), ( $? & 128 ) ? 'with' : 'without' if $? & 127;
-                        'ok!'
-                    };
-                }
-                elsif ( $exe = can_run('ifx') )   { }
-                elsif ( $exe = can_run('ifort') ) { }
-            }
-            #
-            method compile( $file, $obj //= (), $flags //= '' ) {
-                $file = path($file)->absolute unless builtin::blessed $file;
-                $obj //= $file->sibling( $file->basename(qr/\..+?$/) . $Config{_o} );
-                try {
-                    return $compiler->( $self, $file, $obj, $flags );
-                }
-                catch ($err) { warn $err; }
-            }
-
-            method link($objs) {
-                $objs = [ map { builtin::blessed $_ ? $_ : path($_)->absolute } @$objs ];
-                return () unless @$objs;
-                try {
-                    return $linker->( $self, $objs );
-                }
-                catch ($err) { warn $err; }
-            }
-        }
-
-        class Affix::Compiler::File::Dxxx {
-            use Config     qw[%Config];
-            use IPC::Cmd   qw[can_run];
-            use Path::Tiny qw[];
-            field $exe      : reader;
-            field $compiler : reader;
-            field $linker   : reader;
-            field $path     : reader : param;
-            #
-            ADJUST {
-                if ( $exe = can_run('dmd') ) {
-                    $compiler = method( $file, $obj, $flags ) {
-                        system $self->exe, qw[-c -fPIC], $file->stringify;
-                        die "failed to execute: $!\n"                                                                           if $? == -1;
-                        die sprintf "child died with signal %d, %s coredump\n", ( $? & 127 ), ( $? & 128 ) ? 'with' : 'without' if $? & 127;
-                        $obj
-                    };
-                    $linker = method($objs) {
-                        system $self->exe, qw[-shared], ( map { $_->stringify } @$objs ), '-o blah.so';
-                        die "failed to execute: $!\n"                                                                           if $? == -1;
-                        die sprintf "child died with signal %d, %s coredump\n", ( $? & 127 ), ( $? & 128 ) ? 'with' : 'without' if $? & 127;
-                        'ok!'
-                    };
-                }
-            }
-            #
-            method compile( $file, $obj //= (), $flags //= '' ) {
-                $file = Path::Tiny::path($file)->absolute unless builtin::blessed $file;
-                $obj //= $file->sibling( $file->basename(qr/\..+?$/) . $Config{_o} );
-                try {
-                    return $compiler->( $self, $file->stringify, $obj, $flags );
-                }
-                catch ($err) { warn $err; }
-            }
-
-            method link($objs) {
-                $objs = [ map { builtin::blessed $_ ? $_ : Path::Tiny::path($_)->absolute } @$objs ];
-                return () unless @$objs;
-                try {
-                    return $linker->( $self, $objs );
-                }
-                catch ($err) { warn $err; }
-            }
-        }
-    }
 }
 1;
 __END__
@@ -0,0 +1,275 @@
+package Affix::AOT 1.00 {
+    use v5.40;
+    use Carp                  qw[];
+    use Config                qw[%Config];
+    use File::Path            qw[make_path];
+    use File::Basename        qw[dirname];
+    use File::Spec::Functions qw[catdir catfile rel2abs];
+    use Affix                 qw[];
+    $Carp::Internal{ (__PACKAGE__) }++;
+    #
+    # Types a generated wrapper handles itself: C type and how the value crosses over. These follow the push and pull
+    # handlers in Affix.c (SvIV/SvUV/SvNV/SvTRUE in, sv_setiv/sv_setuv/sv_setnv/sv_setbool out). Pointer arguments go
+    # through Affix's own sv_to_c() so pins, undef, and strings are handled just as a JIT binding handles them.
+    my %TYPES = (
+        void      => [ 'void',               'void' ],
+        bool      => [ 'bool',               'bool' ],
+        char      => [ 'int8_t',             'iv' ],
+        uchar     => [ 'uint8_t',            'uv' ],
+        short     => [ 'short',              'iv' ],
+        ushort    => [ 'unsigned short',     'uv' ],
+        int       => [ 'int',                'iv' ],
+        uint      => [ 'unsigned int',       'uv' ],
+        long      => [ 'long',               'iv' ],
+        ulong     => [ 'unsigned long',      'uv' ],
+        longlong  => [ 'long long',          'iv' ],
+        ulonglong => [ 'unsigned long long', 'uv' ],
+        size_t    => [ 'size_t',             'uv' ],
+        ssize_t   => [ 'SSize_t',            'iv' ],
+        float     => [ 'float',              'nv' ],
+        float32   => [ 'float',              'nv' ],
+        double    => [ 'double',             'nv' ],
+        float64   => [ 'double',             'nv' ],
+        '*char'   => [ 'const char *',       'str' ],
+        ( map { ( "sint$_" => [ "int${_}_t", 'iv' ], "int$_" => [ "int${_}_t", 'iv' ], "uint$_" => [ "uint${_}_t", 'uv' ] ) }
+            8, 16, 32, 64 )
+    );
+
+    # Returns [ \@args, $ret ] as entries of %TYPES, or nothing if any part needs the JIT.
+    sub _native ($signature) {
+        my ( $args, $ret ) = $signature =~ m[^\s*\((.*)\)\s*->\s*(.+?)\s*$]s or return;
+        return if $args =~ m[[;()\[\]{}<>]];
+        my @args = map { s[^\s+|\s+$][]gr } split /,/, $args, -1;
+        @args = () if @args == 1 && ( $args[0] eq '' || $args[0] eq 'void' );
+        for my $type ( $ret, @args ) {
+            return unless $TYPES{$type};
+        }
+        return if grep { $_ eq 'void' } @args;
+        [ [ map { $TYPES{$_} } @args ], $TYPES{$ret} ];
+    }
+
+    # Signatures given as [ \@args => $ret ] become the text affix() would build from them.
+    sub _signature ($sig) {
+        return $sig unless ref $sig eq 'ARRAY';
+        my ( $args, $ret ) = @$sig;
+        my $text = '';
+        for my $arg (@$args) {
+            $text .= ',' if length $text && $arg ne ';' && substr( $text, -1 ) ne ';';
+            $text .= $arg;
+        }
+        "($text)->$ret";
+    }
+
+    sub _manifest (%args) {
+        return {
+            lib      => $args{lib},
+            version  => $args{version},
+            types    => [ map {"$_"} @{ $args{types} // [] } ],
+            bindings => { map { $_ => _signature( $args{bindings}{$_} ) } keys %{ $args{bindings} // {} } }
+        };
+    }
+
+    sub _c_string ($text) {
+        '"' . ( $text =~ s[(["\\])][\\$1]gr ) . '"';
+    }
+
+    sub _perl_string ($text) {
+        "'" . ( $text =~ s[(['\\])][\\$1]gr ) . "'";
+    }
+
+    sub _check (%args) {
+        Carp::croak 'A package name is required' unless defined $args{package};
+        Carp::croak "Invalid package name '$args{package}'" unless $args{package} =~ m[^\w+(?:::\w+)*$];
+        Carp::croak 'A library is required' unless defined $args{lib};
+    }
+
+    sub _wrapper ( $index, $plan ) {
+        my ( $args, $ret ) = @$plan;
+        my $proto  = join ', ', map { $_->[0] } @$args;
+        my $fn     = sprintf '%s (*%%s)(%s)', $ret->[0], length $proto ? $proto : 'void';
+        my $values = join ', ', map {
+            my ( $c_type, $kind ) = @{ $args->[$_] };
+            $kind eq 'iv'   ? "($c_type)SvIV(ST($_))" :
+                $kind eq 'uv'   ? "($c_type)SvUV(ST($_))" :
+                $kind eq 'nv'   ? "($c_type)SvNV(ST($_))" :
+                $kind eq 'bool' ? "SvTRUE(ST($_))" :
+                "aot_pointer(aTHX_ ST($_))"
+        } 0 .. $#$args;
+        my $count = scalar @$args;
+        my $c     = "XS_INTERNAL(aot_$index) {\n    dXSARGS;\n";
+        $c .= "    dXSTARG;\n" unless $ret->[1] eq 'void';
+        $c .= "    if (UNLIKELY(items != $count))\n";
+        $c .= qq[        croak("Wrong number of arguments. Expected %d, got %d", $count, (int)items);\n];
+        $c .= sprintf "    $fn = ($fn)aot_target(aTHX_ $index);\n", 'target', '';
+        if ( $ret->[1] eq 'void' ) {
+            return $c . "    target($values);\n    XSRETURN_UNDEF;\n}\n";
+        }
+        $c .= "    $ret->[0] ret = target($values);\n";
+        $c .= {
+            iv   => "    sv_setiv(TARG, (IV)ret);\n",
+            uv   => "    sv_setuv(TARG, (UV)ret);\n",
+            nv   => "    sv_setnv(TARG, (NV)ret);\n",
+            bool => "    sv_setbool(TARG, ret);\n",
+            str  => "    if (ret == NULL)\n        sv_setsv(TARG, &PL_sv_undef);\n    else\n        sv_setpv(TARG, ret);\n"
+        }->{ $ret->[1] };
+        $c . "    ST(0) = TARG;\n    XSRETURN(1);\n}\n";
+    }
+
+    sub _c_source ( $package, $native ) {
+        my @names = sort keys %$native;
+        my $boot  = $package =~ s[::][__]gr;
+        my $c     = <<"END";
+/* Generated by Affix::AOT $Affix::AOT::VERSION for $package. Edit the bindings and regenerate instead. */
+#define PERL_NO_GET_CONTEXT 1
+#include <EXTERN.h>
+#include <perl.h>
+#include <XSUB.h>
+#include "Affix/API.h"
+#include <stdbool.h>
+#include <stdint.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+typedef struct {
+    const char * name;
+    void * ptr;
+} aot_symbol;
+
+// Filled in once by _aot_init(); a symbol the library lacks stays NULL until it is called.
+static aot_symbol aot_symbols[] = {
+END
+        $c .= join '', map {"    {${\ _c_string($_)}, NULL},\n"} @names;
+        $c .= <<'END';
+    {NULL, NULL}};
+
+// Affix's C API and the *char type pointer arguments are converted as, both set by _aot_init().
+static const affix_api * aot_api;
+static affix_type_ref * aot_char_ptr;
+
+static const char * aot_pointer(pTHX_ SV * sv) {
+    void * ptr;
+    aot_api->sv_to_c(aTHX_ sv, aot_api->type_graph(aot_char_ptr), &ptr);
+    return (const char *)ptr;
+}
+
+static void * aot_target(pTHX_ size_t index) {
+    if (UNLIKELY(aot_symbols[index].ptr == NULL))
+        croak("Failed to locate symbol '%s' in library", aot_symbols[index].name);
+    return aot_symbols[index].ptr;
+}
+
+XS_INTERNAL(aot_init) {
+    dXSARGS;
+    if (items != 1)
+        croak_xs_usage(cv, "$lib_path");
+    const char * path = SvPV_nolen(ST(0));
+    if (aot_api == NULL) {
+        aot_api = affix_api_fetch(aTHX);
+        aot_char_ptr = aot_api->type_parse(aTHX_ "*char");
+    }
+#if defined(_WIN32)
+    HMODULE lib = LoadLibraryA(path);
+    if (lib == NULL)
+        croak("Failed to load library: %s", path);
+#else
+    void * lib = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (lib == NULL)
+        croak("Failed to load library: %s", dlerror());
+#endif
+    SP -= items;
+    for (aot_symbol * symbol = aot_symbols; symbol->name != NULL; symbol++) {
+#if defined(_WIN32)
+        symbol->ptr = (void *)GetProcAddress(lib, symbol->name);
+#else
+        symbol->ptr = dlsym(lib, symbol->name);
+#endif
+        if (symbol->ptr == NULL)
+            mXPUSHs(newSVpv(symbol->name, 0));
+    }
+    PUTBACK;
+}
+
+END
+        $c .= join "\n", map { _wrapper( $_, $native->{ $names[$_] } ) } 0 .. $#names;
+        $c .= "\nXS_EXTERNAL(boot_$boot) {\n    dVAR;\n    dXSBOOTARGSXSAPIVERCHK;\n    PERL_UNUSED_VAR(items);\n";
+        $c .= qq[    (void)newXS_flags("${package}::_aot_init", aot_init, __FILE__, "\$", 0);\n];
+        for my $index ( 0 .. $#names ) {
+            my $proto = '$' x @{ $native->{ $names[$index] }[0] };
+            $c .= sprintf qq[    (void)newXS_flags(%s, aot_%d, __FILE__, "%s", 0);\n], _c_string("${package}::$names[$index]"), $index,
+                $proto;
+        }
+        $c . "    Perl_xs_boot_epilog(aTHX_ ax);\n}\n";
+    }
+
+    sub _pm_source ( $package, $manifest, $fallback ) {
+        my $pm = "package $package;\n# Generated by Affix::AOT $Affix::AOT::VERSION. Edit the bindings and regenerate instead.\n";
+        $pm .= "use v5.40;\nuse Carp qw[];\nuse Affix qw[];\nrequire XSLoader;\nXSLoader::load(__PACKAGE__);\n";
+        $pm .= sprintf "my \$lib = Affix::locate_lib( %s, %s ) // Carp::croak %s;\n", _perl_string( $manifest->{lib} ),
+            defined $manifest->{version} ? _perl_string( $manifest->{version} ) : 'undef',
+            _perl_string("Failed to locate library '$manifest->{lib}'");
+        $pm .= "_aot_init(\$lib);\n";
+        if (%$fallback) {
+            my @types = @{ $manifest->{types} };
+            while ( my ( $name, $type ) = splice @types, 0, 2 ) {
+                $pm .= sprintf "Affix::typedef( %s, %s );\n", _perl_string($name), _perl_string($type);
+            }
+            $pm .= "Affix::bind_all(\n    \$lib,\n    {\n";
+            $pm .= join '', map { sprintf "        %s => %s,\n", _perl_string($_), _perl_string( $fallback->{$_} ) } sort keys %$fallback;
+            $pm .= "    },\n    package => __PACKAGE__,\n    lazy    => 1\n);\n";
+        }
+        $pm . "1;\n";
+    }
+
+    sub generate (%args) {
+        _check(%args);
+        my $manifest = _manifest(%args);
+        my ( %native, %fallback );
+        for my $name ( keys %{ $manifest->{bindings} } ) {
+            my $signature = $manifest->{bindings}{$name};
+            my $plan      = _native($signature);
+            $plan ? ( $native{$name} = $plan ) : ( $fallback{$name} = $signature );
+        }
+        return {
+            c        => _c_source( $args{package}, \%native ),
+            pm       => _pm_source( $args{package}, $manifest, \%fallback ),
+            native   => [ sort keys %native ],
+            fallback => [ sort keys %fallback ]
+        };
+    }
+
+    sub build ( $dir, %args ) {
+        my $generated = generate(%args);
+        my @parts     = split /::/, $args{package};
+        require DynaLoader;
+        require ExtUtils::CBuilder;
+        my $mod2fname = defined &DynaLoader::mod2fname ? \&DynaLoader::mod2fname : sub { return $_[0][-1] };
+        my $archdir   = rel2abs catdir( $dir, 'auto', @parts );
+        my $pmdir     = rel2abs catdir( $dir, @parts[ 0 .. $#parts - 1 ] );
+        make_path( $archdir, $pmdir );
+        my $source = catfile( $archdir, $parts[-1] . '.c' );
+        my $pm     = catfile( $pmdir,   $parts[-1] . '.pm' );
+        for ( [ $source, $generated->{c} ], [ $pm, $generated->{pm} ] ) {
+            open my $fh, '>', $_->[0] or Carp::croak "Failed to write '$_->[0]': $!";
+            print $fh $_->[1];
+            close $fh or Carp::croak "Failed to write '$_->[0]': $!";
+        }
+        my $builder = ExtUtils::CBuilder->new( quiet => !$args{verbose} );
+        my $obj     = $builder->compile(
+            source               => $source,
+            include_dirs         => [ dirname $INC{'Affix.pm'} ],
+            extra_compiler_flags => $args{cflags} // ''
+        );
+        my $lib     = $builder->link(
+            objects            => [$obj],
+            lib_file           => catfile( $archdir, $mod2fname->( \@parts ) . '.' . $Config{dlext} ),
+            module_name        => $args{package},
+            extra_linker_flags => join ' ', grep {length} $args{ldflags} // '', ( $Config{libs} =~ m[(-ldl)\b] )
+        );
+        unlink $obj;
+        return { %$generated, pm => $pm, c => $source, lib => $lib };
+    }
+};
+1;
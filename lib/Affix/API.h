@@ -0,0 +1,73 @@
+#pragma once
+/**
+ * @file API.h
+ * @brief Affix's C API, for XS modules that call functions bound with Affix without going through Perl subs.
+ *
+ * Affix publishes one affix_api table in PL_modglobal when it is loaded. Fetch it with affix_api_fetch() after
+ * `require Affix`; every entry is safe to cache for the life of the process.
+ *
+ *     const affix_api * api = affix_api_fetch(aTHX);
+ *     affix_binding * add = api->binding_find(aTHX_ "My::Lib::add");
+ *     int a = 2, b = 3, sum;
+ *     void * args[] = {&a, &b};
+ *     api->binding_call(add, &sum, args);
+ *
+ * Entries are only ever appended. AFFIX_API_VERSION goes up with each addition, so a table whose `version` is at
+ * least the one a module was built against has every entry that module knows about.
+ */
+#include <EXTERN.h>
+#include <perl.h>
+
+/// @brief The version of the table this header describes.
+#define AFFIX_API_VERSION 1
+/// @brief Key of the table in PL_modglobal. The value is a UV holding its address.
+#define AFFIX_API_KEY "Affix::API"
+
+/// @brief A binding made by affix(), wrap() or bind_all(). Owned by its Perl sub, so keep the sub alive.
+typedef struct affix_binding affix_binding;
+/// @brief A type graph. Those of a binding live as long as it does; parsed ones as long as their affix_type_ref.
+typedef struct affix_type affix_type;
+/// @brief A reference on a parsed type graph, released with type_release() in the interpreter that parsed it.
+typedef struct affix_type_ref affix_type_ref;
+
+typedef struct {
+    UV version;   ///< AFFIX_API_VERSION of the Affix that filled the table in.
+    size_t size;  ///< sizeof(affix_api) in that Affix.
+
+    /// @brief The binding installed as the sub `name` (fully qualified), or NULL if it is not one.
+    /// A lazy binding is resolved first, so this croaks if its symbol is missing.
+    affix_binding * (*binding_find)(pTHX_ const char * name);
+    /// @brief The same for a code reference, such as the one wrap() returns.
+    affix_binding * (*binding_from_sv)(pTHX_ SV * sub);
+    size_t (*binding_num_args)(const affix_binding * binding);
+    const affix_type * (*binding_arg_type)(const affix_binding * binding, size_t index);
+    const affix_type * (*binding_return_type)(const affix_binding * binding);
+    /// @brief Calls the bound function. `args` holds a pointer to each C argument and `ret` receives the result,
+    /// exactly as for an infix forward trampoline. Options such as `pure` do not apply here.
+    void (*binding_call)(const affix_binding * binding, void * ret, void ** args);
+
+    /// @brief Parses a type signature, or croaks. The graph is shared with pins of the same type.
+    affix_type_ref * (*type_parse)(pTHX_ const char * signature);
+    const affix_type * (*type_graph)(const affix_type_ref * ref);
+    void (*type_release)(affix_type_ref * ref);
+    size_t (*type_size)(const affix_type * type);
+    size_t (*type_alignment)(const affix_type * type);
+
+    /// @brief Writes `sv` into `dest` as Affix would pass it as an argument of `type`.
+    /// Pointers written to `dest` are borrowed: a string's points into `sv`, and the buffer an ARRAY reference is
+    /// copied into is mortal, freed at the caller's next FREETMPS. Copy anything C keeps beyond that.
+    void (*sv_to_c)(pTHX_ SV * sv, const affix_type * type, void * dest);
+    /// @brief Sets `sv` from the value of `type` at `src`, as Affix would return it.
+    void (*c_to_sv)(pTHX_ const void * src, const affix_type * type, SV * sv);
+} affix_api;
+
+/// @brief The table published by the loaded Affix. Croaks if Affix is not loaded or is older than this header.
+PERL_STATIC_INLINE const affix_api * affix_api_fetch(pTHX) {
+    SV ** svp = hv_fetchs(PL_modglobal, AFFIX_API_KEY, 0);
+    if (svp == NULL)
+        croak("Affix's C API is not available: require Affix first");
+    const affix_api * api = INT2PTR(const affix_api *, SvUV(*svp));
+    if (api->version < AFFIX_API_VERSION)
+        croak("Affix's C API is version %" UVuf " but version %d is needed", api->version, AFFIX_API_VERSION);
+    return api;
+}
@@ -2,13 +2,15 @@ use v5.40;
 use feature qw[class];
 no warnings qw[experimental::class experimental::try];
 use Data::Printer;
+use Affix qw[];
 
 #~ use Carp::Always;
 $|++;
 #
 class Affix::Compiler {
-    use Config     qw[%Config];
-    use Path::Tiny qw[path tempdir];
+    use Config      qw[%Config];
+    use Digest::SHA qw[sha256_hex];
+    use Path::Tiny  qw[path tempdir];
     use File::Spec;
     use ExtUtils::MakeMaker;
     #
@@ -31,8 +33,16 @@ class Affix::Compiler {
         cppflags => $Config{cxxflags}
     };
     field @objs : reader = [];
+    field $include_dirs : param : reader //= [];
+
+    # Objects and libraries are kept here, named by a hash of everything that went into them. Pass a false value to
+    # build from scratch every time.
+    field $cache       : param : reader //= Affix::_cache_dir();
+    field $cache_limit : param : reader //= 64 * 1024 * 1024;
     ADJUST {
         $source = [ map { _filemap($_) } @$source ];
+        $cache  = $cache ? path($cache)->child('compiler') : undef;
+        $cache  = undef if $cache && !eval { $cache->child($_)->mkpath for qw[objects libs deps]; 1 };
     }
     #
     sub _can_run(@cmd) {
@@ -151,13 +161,115 @@ class Affix::Compiler {
         ( 'Affix::Compiler::File::' . ${language} )->new( path => $file );
     }
     #
+    sub _digest(@parts) { sha256_hex( join "\0", map { $_ // '' } @parts ) }
+
+    # Names an object by the key of its source and the current contents of every file it depends on.
+    sub _deps_key( $base, @deps ) { _digest( $base, map { ( $_, -f $_ ? 'file' . path($_)->slurp_raw : 'missing' ) } @deps ) }
+
+    # The prerequisites listed in a make rule written by -MD, made absolute.
+    sub _read_depfile($file) {
+        my $rule = eval { path($file)->slurp_raw } // return;
+        $rule =~ s/\\\r?\n/ /g;
+        my ($deps) = $rule =~ /:\s+(.*)/s or return;
+        map { path( s/\\(.)/$1/gr )->absolute->stringify } grep {length} split /(?<!\\)\s+/, $deps;
+    }
+
+    # First line of `$exe --version`, so upgrading a compiler retires what it built.
+    sub _compiler_id($exe) {
+        state %id;
+        return '' unless length $exe;
+        $id{$exe} //= ( split /\n/, `"$exe" --version 2>&1` // '' )[0] // '';
+    }
+
+    # Written under a temporary name first, so other processes never see half a file.
+    sub _cache_store( $from, $to ) {
+        my $tmp = $to->sibling( $to->basename . '.' . $$ );
+        return 1 if eval { path($from)->copy($tmp); $tmp->move($to); 1 };
+        $tmp->remove;
+        0;
+    }
+
+    # Drops the least recently used entries, other than those in @keep, until the cache fits in $cache_limit. A hit
+    # touches its entry.
+    method _cache_evict(@keep) {
+        my %keep    = map { $_ => 1 } @keep;
+        my @entries = sort { $a->[1] <=> $b->[1] } map { [ $_, ( stat $_ )[ 9, 7 ] ] } map { $cache->child($_)->children } qw[objects libs deps];
+        my $total   = 0;
+        $total += $_->[2] // 0 for @entries;
+        @entries = grep { !$keep{ $_->[0] } } @entries;
+        while ( $total > $cache_limit && @entries ) {
+            my $entry = shift @entries;
+            $total -= $entry->[2] // 0;
+            $entry->[0]->remove;
+        }
+    }
+    #
     method compile() {
-        @objs = grep {defined} map { $_->compile($flags) } @$source;
+        my %build = ( %$flags, include_dirs => $include_dirs );
+        return @objs = grep {defined} map { $_->compile( \%build ) } @$source unless $cache;
+
+        # An object's key covers its source, its compiler and the flags, and then every file the compiler reported reading
+        # the last time it built that source, so headers count wherever they live. Compilers that cannot report their
+        # dependencies are covered for the headers directly inside the include dirs.
+        my $common = _digest( $os, $Config{archname}, ( map { ( $_, $flags->{$_} ) } sort keys %$flags ), @$include_dirs );
+        my ( $stored, @keep ) = (0);
+        @objs = ();
+        for my $file (@$source) {
+            my $compiler = $file->can('compiler') ? $file->compiler : '';
+            my $base     = _digest( $common, ref $file, $compiler, _compiler_id($compiler), $file->path->slurp_raw );
+            my $deps     = $cache->child( 'deps', $base );
+            if ( $deps->is_file ) {
+                my $obj = $cache->child( 'objects', _deps_key( $base, $deps->lines_raw( { chomp => 1 } ) ) . $Config{_o} );
+                if ( $obj->is_file ) {
+                    push @objs, $obj->touch;
+                    push @keep, $deps->touch;
+                    next;
+                }
+            }
+            my $depfile = Path::Tiny->tempfile;
+            my $built   = $file->compile( { %build, depfile => $depfile->stringify } ) // next;
+            my @depends = _read_depfile($depfile);
+            if (@depends) {    # The source itself is already part of the key, wherever it was compiled from.
+                my $path = $file->path->absolute->stringify;
+                @depends = grep { $_ ne $path } @depends;
+            }
+            else {
+                @depends
+                    = map { sort { $a cmp $b } map {"$_"} grep { $_->is_file } path($_)->absolute->children(qr/\.h(?:h|pp|xx)?$/i) } @$include_dirs;
+            }
+            $stored++;
+            my $obj = $cache->child( 'objects', _deps_key( $base, @depends ) . $Config{_o} );
+            push @objs, _cache_store( $built, $obj ) ? $obj : path($built);
+            my $list = Path::Tiny->tempfile;
+            $list->spew_raw( map {"$_\n"} @depends );
+            push @keep, $deps if _cache_store( $list, $deps );
+        }
+        $self->_cache_evict( @objs, @keep ) if $stored;
+        @objs;
     }
 
     method link() {
         return () unless grep { $_->exists } @objs;
-        system( $linker, $flags->{ldflags} // (), '-shared', '-o', $libname->stringify, ( map { $_->absolute->stringify } @objs ) ) ? () : $libname;
+
+        # Cached objects are named by their own key, so together they name the library.
+        my $cached;
+        if ( $cache && !grep { !$cache->child('objects')->subsumes($_) } @objs ) {
+            my $key = _digest( $linker, _compiler_id($linker), $flags->{ldflags}, map { $_->basename } @objs );
+            $cached = $cache->child( 'libs', $key . '-' . $libname->basename );
+            if ( $cached->is_file ) {
+                $cached->touch;
+                $libname->parent->mkpath;
+                return $cached->copy($libname);
+            }
+        }
+        my $linked
+            = system( $linker, $flags->{ldflags} // (), '-shared', '-o', $libname->stringify, ( map { $_->absolute->stringify } @objs ) ) ?
+            () : $libname;
+        if ( $linked && $cached ) {
+            _cache_store( $linked, $cached );
+            $self->_cache_evict( @objs, $cached );
+        }
+        $linked;
     }
 
     #~ field $cxx;
@@ -194,7 +306,9 @@ class Affix::Compiler::File::CPP : isa(Affix::Compiler::File) {
         ;
 
     method compile($flags) {
-        system( $compiler, '-g', '-c', '-fPIC', $flags->{cxxflags} // (), $self->path, '-o', $self->obj ) ? () : $self->obj;
+        my @include = map {"-I$_"} @{ $flags->{include_dirs} // [] };
+        my @depfile = $flags->{depfile} ? ( '-MD', '-MF', $flags->{depfile} ) : ();
+        system( $compiler, '-g', '-c', '-fPIC', $flags->{cxxflags} // (), @include, @depfile, $self->path, '-o', $self->obj ) ? () : $self->obj;
     }
 }
 
@@ -206,7 +320,10 @@ class Affix::Compiler::File::C : isa(Affix::Compiler::File) {
         ;
 
     method compile($flags) {
-        system( $compiler, '-g', '-c', '-Wall', '-fPIC', $flags->{cflags} // (), $self->path, '-o', $self->obj ) ? () : $self->obj;
+        my @include = map {"-I$_"} @{ $flags->{include_dirs} // [] };
+        my @depfile = $flags->{depfile} ? ( '-MD', '-MF', $flags->{depfile} ) : ();
+        system( $compiler, '-g', '-c', '-Wall', '-fPIC', $flags->{cflags} // (), @include, @depfile, $self->path, '-o', $self->obj ) ?
+            () : $self->obj;
     }
 }
 
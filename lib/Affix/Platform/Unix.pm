@@ -50,6 +50,36 @@ package Affix::Platform::Unix 0.5 {
         } split /\R\s*/, `export LC_ALL 'C'; export LANG 'C'; /sbin/ldconfig -p 2>&1`;
     }
 
+    # Every path listed in glibc's ld.so.cache, in the order the dynamic loader searches them.
+    sub _ld_so_cache ( $file = '/etc/ld.so.cache' ) {
+        open my $fh, '<:raw', $file or return;
+        my $data = do { local $/; <$fh> };
+        my $size = length $data;
+        my @paths;
+
+        # Newer caches may follow an old-format section; offsets count from the start of the new header.
+        my $new = substr( $data, 0, 11 ) eq 'ld.so-1.7.0' ? index( $data, 'glibc-ld.so.cache1.1' ) : 0;
+        if ( $new >= 0 && substr( $data, $new, 20 ) eq 'glibc-ld.so.cache1.1' && $size >= $new + 48 ) {
+            my $nlibs = unpack 'L', substr $data, $new + 20, 4;
+            for my $i ( 0 .. $nlibs - 1 ) {
+                my $entry = $new + 48 + $i * 24;
+                last if $entry + 24 > $size;
+                my ( undef, undef, $value ) = unpack 'l L L', substr $data, $entry, 12;
+                push @paths, unpack 'Z*', substr $data, $new + $value if $new + $value < $size;
+            }
+        }
+        elsif ( substr( $data, 0, 11 ) eq 'ld.so-1.7.0' && $size >= 16 ) {    # Offsets count from the string table
+            my $nlibs   = unpack 'L', substr $data, 12, 4;
+            my $strings = 16 + $nlibs * 12;
+            for my $i ( 0 .. $nlibs - 1 ) {
+                last if $strings > $size;
+                my ( undef, undef, $value ) = unpack 'l L L', substr $data, 16 + $i * 12, 12;
+                push @paths, unpack 'Z*', substr $data, $strings + $value if $strings + $value < $size;
+            }
+        }
+        @paths;
+    }
+
     sub _findLib_dynaloader($name) {
         DynaLoader::dl_findfile( '-l' . $name );
     }
@@ -87,10 +117,12 @@ package Affix::Platform::Unix 0.5 {
         }
         CORE::state $cache;
         unless ( defined $cache->{$name}{$version} ) {
-            my @ret = grep { is_elf($_) } _findLib_dynaloader($name);
-            @ret = grep { is_elf($_) } _findLib_ldconfig($name) unless @ret;
-            @ret = grep { is_elf($_) } _findLib_gcc($name)      unless @ret;
-            @ret = grep { is_elf($_) } _findLib_ld($name)       unless @ret;
+            # Installed libraries only: a same-named file in the working directory must not shadow libc.
+            my @ret = grep { is_elf($_) } map { $_->{path} } Affix::_locate_libs( $name, undef, 0 );
+            @ret = grep { is_elf($_) } _findLib_dynaloader($name) unless @ret;
+            @ret = grep { is_elf($_) } _findLib_ldconfig($name)   unless @ret;
+            @ret = grep { is_elf($_) } _findLib_gcc($name)       unless @ret;
+            @ret = grep { is_elf($_) } _findLib_ld($name)        unless @ret;
             return unless @ret;
             for my $lib ( map { path($_)->realpath } @ret ) {
                 next unless $lib =~ /^.*?\/lib$name.*\.$so(?:\.([\d\.\-]+))?$/;
@@ -2,6 +2,7 @@ package Test2::Tools::Affix 0.09 {
     use v5.40;
     use blib;
     use Affix;
+    use Affix::Compiler;
     use Test2::API qw[context run_subtest];
     use Test2::V0 -no_srand => 1, '!subtest';
     use Test2::Util::Importer 'Test2::Tools::Subtest' => ( subtest_streamed => { -as => 'subtest' } );
@@ -33,6 +34,10 @@ package Test2::Tools::Affix 0.09 {
     $Inc = $Inc->child( 't', 'src' );
     my @cleanup;
 
+    # Without a cache dir of the user's, caches stay with the test that made them.
+    my $cache;
+    $ENV{AFFIX_CACHE_DIR} = ( $cache = Path::Tiny->tempdir( CLEANUP => 1 ) )->stringify unless length( $ENV{AFFIX_CACHE_DIR} // '' );
+
     END {
         for my $file ( grep {-f} @cleanup ) {
             unlink $file;
@@ -73,8 +78,7 @@ package Test2::Tools::Affix 0.09 {
                 version      => '1.0',
                 source       => [ $opt->stringify ],    # Ensure we pass string path
                 include_dirs => [ $Inc->stringify ],    # Pass the include dir here
-                cleanup      => !$keep,                 # Map keep to cleanup
-                debug        => 0
+                cleanup      => !$keep                  # Map keep to cleanup
             );
             $compiler->compile;
             $lib_file = $compiler->link;
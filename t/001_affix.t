@@ -303,6 +303,20 @@ subtest 'Library Loading and Lifecycle' => sub {
     my $bad_lib = load_library('non_existent_library_12345.so');
     is $bad_lib,                 undef, 'load_library returns undef for a non-existent library';
     is get_last_error_message(), D(),   'get_last_error_message provides a useful error on failed load';
+    my $add = do {
+        my $lib = load_library($lib_path);
+        wrap( $lib, 'add', '(int32, int32)->int32' );
+    };
+    is $add->( 2, 3 ), 5, 'a binding keeps its library loaded after the Affix::Lib object is gone';
+    undef $lib1;
+    undef $lib2;
+    is $add->( 4, 5 ), 9, '...and after every other Affix::Lib object for it is gone';
+};
+subtest 'Long Signatures' => sub {
+    my $wide = Struct [ map { ( "field_$_" => Int ) } 1 .. 100 ];
+    cmp_ok length $wide, '>', 1024, 'the struct type alone is over 1K';
+    isa_ok my $check_is_null = wrap( $lib_path, 'check_is_null', [ Pointer [$wide] ] => Bool ), ['Affix'];
+    ok $check_is_null->(undef), 'a signature built from a long type list binds and calls';
 };
 
 
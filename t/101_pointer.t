@@ -52,6 +52,29 @@ $$ptr = $message;
 my $ret_ptr = get_ptr();
 warn $ret_ptr;
 
+subtest 'pins share interned type graphs' => sub {
+    my $buf = Affix::calloc( 4, 'uint32' );
+    $$buf = [ 1, 2, 3, 4 ];
+    my @views = map { Affix::calloc( 2, 'uint32' ) } 1 .. 100;
+    undef @views;
+    is $$buf, [ 1, 2, 3, 4 ], 'freeing pins of the same type leaves the rest intact';
+    for my $sig ( '[4:uint32]', ' [ 4 : uint32 ] ', '[4:uint32]' ) {
+        $buf->cast($sig);
+        is $$buf, [ 1, 2, 3, 4 ], "cast('$sig')";
+    }
+    $buf->cast('uint32');
+    is $$buf, 1, 'cast back to the element type';
+    like dies { $buf->cast('[4:nope]') }, qr[cast], 'bad signatures are still reported';
+    is $$buf, 1, '...and leave the pin as it was';
+    my $held = Affix::calloc( 2, 'uint16' );
+    $$held = [ 7, 8 ];
+    $buf->cast("[$_:uint8]") for 1 .. 1000;    # Only read back at the original size
+    $buf->cast('[4:uint32]');
+    is $$buf,  [ 1, 2, 3, 4 ], 'casting through many signatures sheds the idle graphs';
+    is $$held, [ 7, 8 ],       '...but not the ones pins still use';
+    $held->free;
+    $buf->free;
+};
 #~ ...;
 done_testing;
 exit;
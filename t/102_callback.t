@@ -0,0 +1,195 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+use Scalar::Util        qw[weaken];
+#
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+//ext: .c
+
+DLLEXPORT int call_int_cb(int (*cb)(int), int val) { return cb(val); }
+DLLEXPORT double call_dbl_cb(double (*cb)(double), double val) { return cb(val); }
+
+typedef int (*visit_cb)(int value, void * user_data);
+static visit_cb g_cb = NULL;
+static void * g_user_data = NULL;
+DLLEXPORT int visit_each(int * values, int count, visit_cb cb, void * user_data) {
+    int total = 0;
+    for (int i = 0; i < count; i++)
+        total += cb(values[i], user_data);
+    return total;
+}
+DLLEXPORT void on_event(visit_cb cb, void * user_data) { g_cb = cb; g_user_data = user_data; }
+DLLEXPORT int fire_event(int value) { return g_cb ? g_cb(value, g_user_data) : -1; }
+DLLEXPORT size_t event_cb(void) { return (size_t)g_cb; }
+static visit_cb g_slot_cb[2];
+static void * g_slot_data[2];
+DLLEXPORT void on_slot(int slot, visit_cb cb, void * user_data) { g_slot_cb[slot] = cb; g_slot_data[slot] = user_data; }
+DLLEXPORT int fire_slot(int slot, int value) { return g_slot_cb[slot](value, g_slot_data[slot]); }
+
+typedef struct { int scale; } collation;
+DLLEXPORT collation * new_collation(int scale) {
+    static collation c;
+    c.scale = scale;
+    return &c;
+}
+DLLEXPORT int scaled_cmp(collation * c, int a, int b) { return (a - b) * c->scale; }
+DLLEXPORT int apply_cmp(int (*cmp)(int, int), int a, int b) { return cmp(a, b); }
+DLLEXPORT int joined_len(const char * prefix, const char * s) { return (int)(strlen(prefix) + strlen(s)); }
+DLLEXPORT int apply_str(int (*f)(const char *), const char * s) { return f(s); }
+
+static int op_add(int a, int b) { return a + b; }
+static int op_mul(int a, int b) { return a * b; }
+static double op_half(double a) { return a / 2; }
+DLLEXPORT void * get_op(int which) { return which == 0 ? (void *)op_add : which == 1 ? (void *)op_mul : (void *)op_half; }
+DLLEXPORT int add_int(int a, int b) { return a + b; }
+DLLEXPORT int mul_int(int a, int b) { return a * b; }
+END_C
+#
+isa_ok my $call_int = wrap( $lib_path, 'call_int_cb', '(*((int32)->int32), int32)->int32' ), ['Affix'];
+isa_ok my $call_dbl = wrap( $lib_path, 'call_dbl_cb', '(*((double)->double), double)->double' ), ['Affix'];
+subtest 'one coderef, two signatures' => sub {
+    my $twice = sub { $_[0] * 2 };
+    is $call_int->( $twice, 21 ),   42,  'called with an int signature';
+    is $call_dbl->( $twice, 1.25 ), 2.5, 'double signature gets a trampoline of its own';
+    is $call_int->( $twice, 5 ),    10,  'int trampoline is reused';
+    is Affix::release_callback($twice), 2, 'both trampolines released';
+    is Affix::release_callback($twice), 0, 'nothing left to release';
+    is $call_int->( $twice, 4 ), 8, 'released coderef can still be passed again';
+    Affix::release_callback($twice);
+};
+subtest 'released closures are reclaimed' => sub {
+    my $weak;
+    {
+        my $offset  = 3;
+        my $closure = sub { $_[0] + $offset };
+        $weak = $closure;
+        weaken $weak;
+        is $call_int->( $closure, 4 ), 7, 'closure called from C';
+        ok Affix::release_callback($closure), 'closure released';
+    }
+    is $weak, undef, 'closure and its trampoline are gone';
+};
+subtest 'trampolines go with their coderef' => sub {
+    my $weak;
+    {
+        my $offset  = -1;
+        my $closure = sub { $_[0] + $offset };
+        $weak = $closure;
+        weaken $weak;
+        is $call_int->( $closure, 1 ), 0, 'closure called from C';
+    }
+    is $weak, undef, 'trampolines do not keep an unreleased closure alive';
+    my $live = Affix::live_callbacks();
+    for my $n ( 1 .. 100 ) {
+        $call_int->( sub { $_[0] + $n }, 1 );
+        $call_dbl->( sub { $_[0] / $n }, 1 );
+    }
+    is Affix::live_callbacks(), $live, 'anonymous callbacks in a loop leave no trampolines behind';
+    my $keep = sub { $_[0] + $live };    # A closure, so undef frees it
+    $call_int->( $keep, 1 );
+    is Affix::live_callbacks(), $live + 1, 'a coderef that is still referenced keeps its trampoline';
+    undef $keep;
+    is Affix::live_callbacks(), $live, '...until it goes';
+};
+subtest 'shared trampolines for callbacks with user data' => sub {
+    my $visit_cb = Callback [ [ Int, UserData ] => Int ];
+    isa_ok my $visit = wrap( $lib_path, 'visit_each', [ Pointer [Int], Int, $visit_cb, UserData ] => Int ), ['Affix'];
+    is $visit->( [ 1, 2, 3 ], 3, sub ( $v, $data ) { $v * $data->{scale} }, { scale => 10 } ), 60,
+        'user data is handed back to the coderef';
+    is $visit->( [ 1, 2, 3 ], 3, sub ( $v, $data ) { defined $data ? -1 : $v }, undef ), 6, 'undef user data';
+    my $scaled = sub ( $v, $data ) { $v * $data->{scale} };
+    my $stale;
+    for my $scale ( 1 .. 100 ) {
+        my $data = { scale => $scale };
+        $visit->( [ 1, 2, 3 ], 3, $scaled, $data );
+        weaken( $stale = $data ) if $scale == 1;
+    }
+    ok defined $stale, 'each registration keeps its user data';
+    Affix::release_callback($scaled);
+    ok !defined $stale, '...until the coderef is released';
+    is $visit->( [ 1, 2, 3 ], 3, $scaled, { scale => 2 } ), 12, '...and each call sees its own';
+    isa_ok my $on_slot   = wrap( $lib_path, 'on_slot',   [ Int, $visit_cb, UserData ] => Void ), ['Affix'];
+    isa_ok my $fire_slot = wrap( $lib_path, 'fire_slot', [ Int, Int ]                 => Int ),  ['Affix'];
+    $on_slot->( 0, $scaled, { scale => 2 } );
+    $on_slot->( 1, $scaled, { scale => 3 } );
+    is $fire_slot->( 0, 5 ), 10, 'one coderef registered twice: first registration sees its own data';
+    is $fire_slot->( 1, 5 ), 15, '...and so does the second';
+    Affix::release_callback($scaled);
+    #
+    isa_ok my $on_event = wrap( $lib_path, 'on_event',   [ $visit_cb, UserData ] => Void ), ['Affix'];
+    isa_ok my $fire     = wrap( $lib_path, 'fire_event', [Int]                  => Int ),  ['Affix'];
+    isa_ok my $event_cb = wrap( $lib_path, 'event_cb',   []                     => Size_t ),  ['Affix'];
+    my $first = sub ( $v, $data ) { $v + 1 };
+    $on_event->( $first, undef );
+    is $fire->(1), 2, 'first handler';
+    my $first_ptr = $event_cb->();
+    my $second = sub ( $v, $data ) { $v . $data };    # C keeps it, so we must too
+    $on_event->( $second, 0 );
+    is $fire->(1), 10, 'second handler';
+    is $event_cb->(), $first_ptr, 'both coderefs share a single trampoline';
+    $on_event->( undef, undef );
+    is $fire->(1), -1, 'undef clears the callback';
+    Affix::release_callback($_) for $first, $second;
+    my $live = Affix::live_callbacks();
+    for my $n ( 1 .. 100 ) {
+        $visit->( [ 1, 2, 3 ], 3, sub ( $v, $data ) { $v * $data + $n }, $n );
+    }
+    is Affix::live_callbacks(), $live, 'anonymous callbacks with user data leave no records behind';
+};
+subtest 'bind_native' => sub {
+    my $lib = load_library($lib_path);
+    isa_ok my $new_coll  = wrap( $lib_path, 'new_collation', '(int32)->*void' ),                            ['Affix'];
+    isa_ok my $apply_cmp = wrap( $lib_path, 'apply_cmp',     '(*((int32, int32)->int32), int32, int32)->int32' ), ['Affix'];
+    isa_ok my $apply_str = wrap( $lib_path, 'apply_str',     '(*((*char)->int32), *char)->int32' ),              ['Affix'];
+    my $cmp = Affix::bind_native( find_symbol( $lib, 'scaled_cmp' ), '(*void, int32, int32)->int32', $new_coll->(3) );
+    ok $cmp, 'bound the context pointer';
+    is $apply_cmp->( $cmp, 5, 3 ), 6,  'C calls the native function with the bound context';
+    is $apply_cmp->( $cmp, 1, 4 ), -9, 'and again, without a trip through Perl';
+    my $len = Affix::bind_native( find_symbol( $lib, 'joined_len' ), '(*char, *char)->int32', 'abc' );
+    is $apply_str->( $len, 'de' ), 5, 'bound string is copied and kept alive';
+    like dies { Affix::bind_native( find_symbol( $lib, 'joined_len' ), '(*char, *char)->int32', 1, 2, 3 ) },
+        qr[only takes], 'too many bound arguments';
+};
+subtest 'call_ptr' => sub {
+    isa_ok my $get_op = wrap( $lib_path, 'get_op', '(int32)->*void' ), ['Affix'];
+    my ( $add, $mul, $half ) = map { $get_op->($_) } 0 .. 2;
+    is Affix::call_ptr( $add,  '(int32, int32)->int32', 2, 3 ), 5, 'first function pointer';
+    is Affix::call_ptr( $mul,  '(int32, int32)->int32', 2, 3 ), 6, 'second pointer, same signature';
+    is Affix::call_ptr( $half, '(double)->double',      5 ),    2.5, 'another signature';
+    is Affix::call_ptr( $add,  '(int32, int32)->int32', 4, 4 ), 8, 'and back again';
+    like dies { Affix::call_ptr( $add, '(int32, int32)->int32', 1 ) }, qr[Wrong number of arguments], 'arity is checked';
+    like dies { Affix::call_ptr( undef, '()->void' ) }, qr[function pointer], 'pointer is required';
+    ok typedef('@CallPtr::Num = int32;'), 'typedef for a cached plan';
+    my $apply = find_symbol( load_library($lib_path), 'apply_cmp' );
+    my $sig   = '(*((@CallPtr::Num, @CallPtr::Num)->int32), int32, int32)->int32';
+    is Affix::call_ptr( $apply, $sig, sub ( $x, $y ) { typedef('@CallPtr::Num = int32;'); $x - $y }, 7, 2 ), 5,
+        'plan survives being dropped from the cache while it runs';
+    is Affix::call_ptr( $apply, $sig, sub ( $x, $y ) { $x * $y }, 7, 2 ), 14, '...and is rebuilt afterwards';
+};
+subtest 'bindings share a trampoline per signature' => sub {
+    isa_ok my $add_int = wrap( $lib_path, 'add_int', '(int32, int32)->int32' ), ['Affix'];
+    isa_ok my $mul_int = wrap( $lib_path, 'mul_int', ' ( int32,int32 ) -> int32 ' ), ['Affix'];
+    is $add_int->( 2, 3 ), 5, 'first binding';
+    is $mul_int->( 2, 3 ), 6, 'second binding, same signature spelled differently';
+    isa_ok my $get_op = wrap( $lib_path, 'get_op', '(int32)->*void' ), ['Affix'];
+    is Affix::call_ptr( $get_op->(1), '(int32, int32)->int32', 4, 5 ), 20, 'call_ptr through the same trampoline';
+    is $add_int->( 4, 5 ), 9, 'bindings keep their own target';
+    undef $mul_int;
+    is $add_int->( 1, 1 ), 2, 'and outlive each other';
+};
+like dies { Affix::release_callback('nope') }, qr[code reference], 'release_callback requires a coderef';
+subtest 'release_callback inside the callback' => sub {
+    my @warnings;
+    local $SIG{__WARN__} = sub { push @warnings, @_ };
+    my $self;
+    $self = sub { Affix::release_callback($self); 1 };
+    $call_int->( $self, 1 );
+    like \@warnings, [qr[while it is running]], 'a callback cannot free its own trampoline';
+    is Affix::release_callback($self), 1, '...but can be released once it returns';
+    undef $self;
+};
+#
+done_testing;
@@ -0,0 +1,64 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+#
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+//ext: .c
+
+typedef struct { int value; } boxed;
+DLLEXPORT boxed * box_new(int v) {
+    boxed * b = malloc(sizeof *b);
+    b->value = v;
+    return b;
+}
+DLLEXPORT int box_take(boxed * b) {
+    int v = b->value;
+    free(b);
+    return v;
+}
+DLLEXPORT int add_one(int v) { return v + 1; }
+DLLEXPORT double halve(double v) { return v / 2; }
+DLLEXPORT void put_int(int * out, int v) { *out = v; }
+DLLEXPORT int sum(int a, int b) { return a + b; }
+END_C
+#
+isa_ok my $box_new  = wrap( $lib_path, 'box_new',  '(int32)->*void' ),         ['Affix'];
+isa_ok my $box_take = wrap( $lib_path, 'box_take', '(*void)->int32' ),         ['Affix'];
+isa_ok my $add_one  = wrap( $lib_path, 'add_one',  '(int32)->int32' ),         ['Affix'];
+isa_ok my $halve    = wrap( $lib_path, 'halve',    '(double)->double' ),       ['Affix'];
+isa_ok my $sum      = wrap( $lib_path, 'sum',      '(int32, int32)->int32' ),  ['Affix'];
+isa_ok my $put_int  = wrap( $lib_path, 'put_int',  '(*int32, int32)->void' ),  ['Affix'];
+subtest 'raw values flow between stages' => sub {
+    isa_ok my $roundtrip = Affix::chain( $box_new, $box_take, $add_one ), ['Affix::Chain'];
+    is $roundtrip->(41), 42, 'box_new -> box_take -> add_one';
+    is $roundtrip->(-1), 0,  'called again';
+    isa_ok my $sum_plus = Affix::chain( $sum, $add_one, $add_one ), ['Affix::Chain'];
+    is $sum_plus->( 2, 3 ), 7, 'first stage may take several arguments';
+    is Affix::chain($add_one)->(1), 2, 'single stage';
+};
+subtest 'first stage writes back out params' => sub {
+    my $chain = Affix::chain($put_int);
+    my $out   = 0;
+    $chain->( \$out, 9 );
+    is $out, 9, 'out param updated';
+};
+subtest 'chains keep their bindings alive' => sub {
+    my $chain;
+    {
+        my $inc = wrap( $lib_path, 'add_one', '(int32)->int32' );
+        $chain = Affix::chain( $inc, $inc );
+    }
+    is $chain->(1), 3, 'bindings outlived their variables';
+};
+subtest 'errors' => sub {
+    like dies { Affix::chain( $add_one, $sum ) },     qr[exactly one argument], 'later stages take one argument';
+    like dies { Affix::chain( $add_one, $halve ) },   qr[cannot take the return value], 'types must line up';
+    like dies { Affix::chain( $put_int, $add_one ) }, qr[cannot take the return value], 'void cannot feed a stage';
+    like dies { Affix::chain( sub {1} ) },            qr[not an Affix binding], 'plain coderefs are rejected';
+    like dies { Affix::chain($sum)->(1) },            qr[Wrong number of arguments], 'arity is checked';
+};
+#
+done_testing;
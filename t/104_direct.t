@@ -0,0 +1,80 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+#
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+//ext: .c
+
+typedef struct { int x; int y; } point;
+DLLEXPORT int add(int a, int b) { return a + b; }
+DLLEXPORT bool negate(bool b) { return !b; }
+DLLEXPORT void set_int(int * out, int v) { *out = v; }
+DLLEXPORT void set_double(double * out, double v) { *out = v; }
+DLLEXPORT void set_str(const char ** out) { *out = "from C"; }
+DLLEXPORT int sum_ints(int * values, int count) {
+    int total = 0;
+    for (int i = 0; i < count; i++)
+        total += values[i];
+    return total;
+}
+DLLEXPORT int call_cb(int (*cb)(int), int v) { return cb(v); }
+DLLEXPORT int point_sum(point p) { return p.x + p.y; }
+DLLEXPORT void point_move(point * p, int dx) { p->x += dx; }
+DLLEXPORT unsigned char max_u8(void) { return 255; }
+DLLEXPORT short neg_short(void) { return -2; }
+DLLEXPORT float third(void) { return 1.0f / 3; }
+DLLEXPORT double half(double v) { return v / 2; }
+DLLEXPORT long long big(void) { return 1LL << 40; }
+END_C
+#
+subtest scalars => sub {
+    my $add = direct_wrap( $lib_path, 'add', '(int32, int32)->int32' );
+    is $add->( 2, 3 ),     5, 'ints';
+    is $add->( '4', 1.0 ), 5, 'strings and numbers take the slow path';
+    my $negate = direct_wrap( $lib_path, 'negate', '(bool)->bool' );
+    ok !$negate->('yes'), 'bool follows Perl truth';
+};
+subtest 'out parameters' => sub {
+    my $set_int = direct_wrap( $lib_path, 'set_int', '(*int32, int32)->void' );
+    my $i       = 0;
+    $set_int->( \$i, 42 );
+    is $i, 42, '*int';
+    my $set_double = direct_wrap( $lib_path, 'set_double', '(*double, double)->void' );
+    my $d          = 0;
+    $set_double->( \$d, 1.5 );
+    is $d, 1.5, '*double';
+    my $set_str = direct_wrap( $lib_path, 'set_str', '(**char)->void' );
+    my $s       = 'from Perl';
+    $set_str->( \$s );
+    is $s, 'from C', '**char';
+};
+subtest 'arrays and callbacks' => sub {
+    my $sum_ints = direct_wrap( $lib_path, 'sum_ints', '(*int32, int32)->int32' );
+    is $sum_ints->( [ 1, 2, 3, 4 ], 4 ), 10, 'array reference';
+    my $call_cb = direct_wrap( $lib_path, 'call_cb', '(*((int32)->int32), int32)->int32' );
+    is $call_cb->( sub { $_[0] * 3 }, 5 ), 15, 'callback';
+};
+subtest structs => sub {
+    my $point_sum = direct_wrap( $lib_path, 'point_sum', '({x:int32, y:int32})->int32' );
+    is $point_sum->( { x => 1, y => 2 } ), 3, 'by value';
+    my $point_move = direct_wrap( $lib_path, 'point_move', '(*{x:int32, y:int32}, int32)->void' );
+    my %p = ( x => 1, y => 2 );
+    $point_move->( \%p, 10 );
+    is \%p, { x => 11, y => 2 }, 'by pointer, written back';
+};
+subtest 'return values' => sub {
+    is direct_wrap( $lib_path, 'max_u8',    '()->uint8' )->(),         255,     'uint8';
+    is direct_wrap( $lib_path, 'neg_short', '()->sint16' )->(),        -2,      'sint16';
+    is direct_wrap( $lib_path, 'big',       '()->sint64' )->(),        2**40,   'sint64';
+    is direct_wrap( $lib_path, 'half',      '(double)->double' )->(5), 2.5,     'double';
+    like direct_wrap( $lib_path, 'third', '()->float' )->(), qr[^0\.333333], 'float';
+    is direct_wrap( $lib_path, 'set_int', '(*int32, int32)->void' )->( \( my $i = 0 ), 1 ), undef, 'void';
+    my $half = direct_wrap( $lib_path, 'half', '(double)->double' );
+    my @got  = map { $half->($_) } 1 .. 3;
+    is \@got, [ 0.5, 1, 1.5 ], 'each call returns its own value';
+};
+#
+done_testing;
@@ -0,0 +1,84 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+#
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+//ext: .c
+
+static int calls = 0;
+DLLEXPORT int call_count(void) { return calls; }
+DLLEXPORT int square(int v) { calls++; return v * v; }
+DLLEXPORT double scale(double v, int by) { calls++; return v * by; }
+DLLEXPORT long double halve(long double v, int by) { calls++; return v / 2 * by; }
+DLLEXPORT int str_length(const char * s) { calls++; return s ? (int)strlen(s) : 0; }
+DLLEXPORT void touch(int * p) { calls++; }
+END_C
+#
+my $calls = wrap( $lib_path, 'call_count', '()->int32' );
+subtest 'repeated arguments skip the call' => sub {
+    my $square = wrap( $lib_path, 'square', '(int32)->int32', { pure => 1 } );
+    my $before = $calls->();
+    is $square->(3), 9, 'first call';
+    is $square->(3), 9, 'cached call';
+    is $square->(4), 16, 'new argument';
+    is $calls->() - $before, 2, 'C was called once per distinct argument';
+    is memo_stats($square), { hits => 1, misses => 2, size => 2, capacity => 256 }, 'memo_stats';
+    memo_clear($square);
+    is memo_stats($square), { hits => 0, misses => 0, size => 0, capacity => 256 }, 'memo_clear';
+    is $square->(3), 9, 'called again after clearing';
+    is $calls->() - $before, 3, 'cleared results are recomputed';
+};
+subtest 'several arguments' => sub {
+    my $scale  = wrap( $lib_path, 'scale', '(double, int32)->double', { pure => 1 } );
+    my $before = $calls->();
+    is $scale->( 1.5, 2 ), 3, 'first call';
+    is $scale->( 1.5, 3 ), 4.5, 'second argument differs';
+    is $scale->( 1.5, 2 ), 3, 'cached';
+    is $calls->() - $before, 2, 'one call per distinct argument list';
+};
+subtest 'long doubles are keyed by value' => sub {
+    my $halve  = wrap( $lib_path, 'halve', '(longdouble, int32)->longdouble', { pure => 1 } );
+    my $before = $calls->();
+    is $halve->( 3, 1 ), 1.5, 'first call';
+    is $halve->( 5, 1 ), 2.5, 'new value';
+    is $halve->( 3, 1 ), 1.5, 'cached, whatever the padding after the value holds';
+    is $halve->( 3, 2 ), 3,   'argument after the long double differs';
+    is $calls->() - $before, 3, 'one call per distinct argument list';
+};
+subtest 'strings are keyed by content' => sub {
+    my $length = wrap( $lib_path, 'str_length', '(*char)->int32', { pure => 1 } );
+    my $before = $calls->();
+    my $str    = 'hello';
+    is $length->($str), 5, 'first call';
+    $str = 'hello, world';
+    is $length->($str),    12, 'same variable, new contents';
+    is $length->('hello'), 5,  'cached by contents';
+    is $length->(undef),   0,  'undef is its own key';
+    is $length->(''),      0,  'distinct from the empty string';
+    is $calls->() - $before, 4, 'one call per distinct string';
+};
+subtest 'least recently used results are evicted' => sub {
+    my $square = wrap( $lib_path, 'square', '(int32)->int32', { pure => 1, cache_size => 2 } );
+    my $before = $calls->();
+    $square->($_) for 1, 2, 1, 3;    # 2 is the least recently used when 3 arrives
+    is $calls->() - $before, 3, 'three misses';
+    $square->(1);
+    is $calls->() - $before, 3, '1 is still cached';
+    $square->(2);
+    is $calls->() - $before, 4, '2 was evicted';
+    is memo_stats($square)->{size}, 2, 'size is bounded';
+};
+subtest 'errors' => sub {
+    is memo_stats( wrap( $lib_path, 'square', '(int32)->int32' ) ), undef, 'not pure';
+    like dies { wrap( $lib_path, 'touch', '(*int32)->void', { pure => 1 } ) }, qr[only take numbers and strings],
+        'pointers are rejected';
+    like dies { wrap( $lib_path, 'square', '(int32)->int32', { pure => 1, cache_size => 0 } ) }, qr[at least 1],
+        'cache_size must be positive';
+    like dies { wrap( $lib_path, 'square', '(int32)->int32', { purity => 1 } ) }, qr[Unknown option], 'unknown options';
+    like dies { memo_stats( sub {1} ) }, qr[expects an Affix binding], 'plain coderefs are rejected';
+};
+#
+done_testing;
@@ -0,0 +1,66 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+#
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+#include <stdarg.h>
+//ext: .c
+
+/* Each format character names the type of one variadic argument. */
+DLLEXPORT double mixed(const char * fmt, ...) {
+    va_list ap;
+    double total = 0;
+    va_start(ap, fmt);
+    for (; *fmt; fmt++) {
+        switch (*fmt) {
+        case 'i': total += va_arg(ap, int); break;
+        case 'l': total += (double)va_arg(ap, long long); break;
+        case 'd': total += va_arg(ap, double); break;
+        case 's': total += strlen(va_arg(ap, const char *)); break;
+        case 'p': total += va_arg(ap, void *) == NULL ? 0 : 1; break;
+        }
+    }
+    va_end(ap);
+    return total;
+}
+END_C
+#
+subtest 'shapes come from the arguments' => sub {
+    isa_ok my $mixed = wrap( $lib_path, 'mixed', '(*char;)->double' ), ['Affix::Variadic'];
+    is $mixed->(''),                       0,     'no variadic arguments';
+    is $mixed->( 'i', 3 ),                 3,     'int';
+    is $mixed->( 'ii', 3, -4 ),            -1,    'two ints';
+    is $mixed->( 'd', 1.25 ),              1.25,  'double';
+    is $mixed->( 'l', 1 << 40 ),            1 << 40, 'too big for an int';
+    is $mixed->( 'sid', 'four', 1, 0.5 ),  5.5,   'string, int, double';
+    is $mixed->( 'p', undef ),             0,     'undef is a null pointer';
+    my ( $numified, $stringified ) = ( '42', 7 );
+    () = ( $numified + 0, "$stringified" );    # Each picks up the other's flags
+    is $mixed->( 's', $numified ),         2,     'a string used as a number is still a string';
+    is $mixed->( 'i', $stringified ),      7,     'a number used as a string is still a number';
+    is $mixed->( 'l', typed( LongLong, 7 ) ), 7, 'typed() overrides inference';
+    like dies { $mixed->() },              qr[at least 1], 'fixed arguments are required';
+    like dies { $mixed->( 'p', [] ) },     qr[reference], 'references need typed()';
+};
+subtest 'array form' => sub {
+    isa_ok my $mixed = wrap( $lib_path, 'mixed', [ String, VarArgs ] => Double ), ['Affix::Variadic'];
+    is $mixed->( 'ii', 1, 2 ), 3, 'VarArgs marks the open variadic part';
+    isa_ok my $fixed = wrap( $lib_path, 'mixed', [ String, VarArgs, Int, Double ] => Double ), ['Affix'];
+    is $fixed->( 'id', 1, 2.5 ), 3.5, 'a fixed variadic shape is still an ordinary binding';
+};
+subtest 'trampolines are cached per shape' => sub {
+    my $mixed = wrap( $lib_path, 'mixed', '(*char;)->double' );
+    $mixed->( 'i', $_ ) for 1 .. 5;
+    $mixed->( 'd', $_ + 0.5 ) for 1 .. 5;
+    is memo_stats($mixed), { hits => 8, misses => 2, size => 2, capacity => 16 }, 'one compile per shape';
+    $mixed->( 'i' x $_, (1) x $_ ) for 1 .. 20;
+    is memo_stats($mixed)->{size}, 16, 'bounded';
+    is $mixed->( 'i' x 20, (1) x 20 ), 20, 'still correct after eviction';
+    memo_clear($mixed);
+    is memo_stats($mixed)->{size}, 0, 'memo_clear';
+};
+#
+done_testing;
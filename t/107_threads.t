@@ -0,0 +1,89 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Config;
+use Test2::Tools::Affix qw[:all];
+BEGIN {
+    skip_all 'perl was built without ithreads' unless $Config{useithreads};
+}
+use threads;
+use threads::shared;
+use Affix qw[:all];
+#
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+//ext: .c
+
+DLLEXPORT int add(int a, int b) { return a + b; }
+DLLEXPORT int twice(int v) { return v * 2; }
+DLLEXPORT void put_int(int * out, int v) { *out = v; }
+DLLEXPORT int apply(int (*cb)(int), int v) { return cb(v); }
+DLLEXPORT int apply_ud(int (*cb)(int, void *), void * ud, int v) { return cb(v, ud); }
+typedef struct { int x, y; } point;
+DLLEXPORT int point_sum(point p) { return p.x + p.y; }
+static int slot = 7;
+DLLEXPORT int * slot_ptr(void) { return &slot; }
+END_C
+#
+typedef Point => Struct [ x => Int, y => Int ];
+my $add       = wrap( $lib_path, 'add',       '(int32, int32)->int32' );
+my $twice     = wrap( $lib_path, 'twice',     '(int32)->int32', { pure => 1 } );
+my $put_int   = wrap( $lib_path, 'put_int',   '(*int32, int32)->void' );
+my $apply     = wrap( $lib_path, 'apply',     '(*((int32)->int32), int32)->int32' );
+my $point_sum = wrap( $lib_path, 'point_sum', '(@Point)->int32' );
+my $chain     = Affix::chain( $add, $twice );
+is $twice->(5), 10, 'parent fills its cache';
+#
+subtest 'bindings work in new threads' => sub {
+    my @results = map { $_->join } map {
+        my $n = $_;
+        threads->create(
+            sub {
+                my $out = 0;
+                $put_int->( \$out, $n );
+                return [
+                    $add->( $n, 1 ), $twice->($n), $twice->($n), $out, $apply->( sub { $_[0] + 100 }, $n ),
+                    $point_sum->( { x => $n, y => 1 } ), $chain->( $n, 1 ), memo_stats($twice)->{hits}
+                ];
+            }
+        )
+    } 1 .. 4;
+    is $results[ $_ - 1 ], [ $_ + 1, $_ * 2, $_ * 2, $_, $_ + 100, $_ + 1, ( $_ + 1 ) * 2, 1 ], "thread $_"
+        for 1 .. 4;
+};
+subtest 'bindings made in a thread' => sub {
+    my $sum = threads->create( sub { wrap( $lib_path, 'add', '(int32, int32)->int32' )->( 20, 22 ) } )->join;
+    is $sum, 42, 'bound and called inside the thread';
+};
+subtest 'shared callbacks outlive the thread that made them' => sub {
+    my $done : shared = 0;
+    my $tid = threads->create(
+        sub {
+            my $apply_ud = wrap( $lib_path, 'apply_ud', [ Callback [ [ Int, UserData ] => Int ], UserData, Int ] => Int );
+            $apply_ud->( sub { $_[0] }, undef, 1 );    # Builds the shared trampoline here
+            threads->create(
+                sub {
+                    threads->yield until $done;
+                    $apply_ud->( sub ( $v, $by ) { $v * $by }, 6, 7 );
+                }
+            )->tid;
+        }
+    )->join;
+    $done = 1;
+    is threads->object($tid)->join, 42, 'called after its maker was destroyed';
+};
+subtest 'pins returned by a binding cross into threads' => sub {
+    my $pin = wrap( $lib_path, 'slot_ptr', '()->*int32' )->();    # The binding is freed once it returns
+    is $$pin, 7, 'read in the parent';
+    is threads->create( sub { $$pin } )->join, 7, 'read in a thread';
+    is $$pin, 7, '...and still in the parent';
+};
+subtest 'parent is unaffected' => sub {
+    is $add->( 2, 3 ), 5, 'binding';
+    is $twice->(5), 10, 'cached binding';
+    is memo_stats($twice)->{hits}, 1, 'threads did not touch the parent cache';
+    is $chain->( 1, 2 ), 6, 'chain';
+    is $apply->( sub { $_[0] * 3 }, 3 ), 9, 'callback';
+};
+#
+done_testing;
@@ -0,0 +1,61 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+#
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+//ext: .c
+
+static int calls = 0;
+DLLEXPORT int call_count(void) { return calls; }
+DLLEXPORT int add(int a, int b) { calls++; return a + b; }
+DLLEXPORT int twice(int v) { calls++; return v * 2; }
+DLLEXPORT int apply(int (*f)(int), int v) { return f(v); }
+END_C
+#
+my $calls = wrap( $lib_path, 'call_count', '()->int32' );
+subtest 'resolved on the first call' => sub {
+    isa_ok my $add = wrap( $lib_path, 'add', '(int32, int32)->int32', { lazy => 1 } ), ['Affix'];
+    my $before = $calls->();
+    is $add->( 2, 3 ), 5, 'first call';
+    is $add->( 4, 5 ), 9, 'second call';
+    is $calls->() - $before, 2, 'both calls reached C';
+};
+subtest 'named bindings keep their prototype' => sub {
+    affix $lib_path, [ add => 'lazy_add' ], '(int32, int32)->int32', { lazy => 1 };
+    is prototype( \&lazy_add ), '$$', 'prototype is known before the first call';
+    is lazy_add( 1, 1 ), 2, 'called by name';
+    affix $lib_path, [ call_count => 'lazy_count' ], '()->int32', { lazy => 1 };
+    is prototype( \&lazy_count ), '', 'no arguments';
+    affix $lib_path, [ apply => 'lazy_apply' ], '(*((int32)->int32), int32)->int32', { lazy => 1 };
+    is prototype( \&lazy_apply ), '$$', 'nested signatures count as one argument';
+};
+subtest 'options apply once resolved' => sub {
+    my $twice  = wrap( $lib_path, 'twice', '(int32)->int32', { lazy => 1, pure => 1 } );
+    my $before = $calls->();
+    is $twice->(4), 8, 'first call';
+    is $twice->(4), 8, 'cached';
+    is $calls->() - $before, 1, 'pure binding reached C once';
+    is memo_stats($twice)->{hits}, 1, 'memo_stats';
+};
+subtest 'chained before the first call' => sub {
+    my $add   = wrap( $lib_path, 'add',   '(int32, int32)->int32', { lazy => 1 } );
+    my $twice = wrap( $lib_path, 'twice', '(int32)->int32',        { lazy => 1 } );
+    is Affix::chain( $add, $twice )->( 1, 2 ), 6, 'chain resolves its stages';
+};
+subtest 'errors' => sub {
+    ok my $missing = wrap( $lib_path, 'no_such_function', '()->void', { lazy => 1 } ), 'binding a missing symbol succeeds';
+    like dies { $missing->() }, qr[no_such_function], 'the first call reports it';
+    like dies { wrap( $lib_path, 'add', '(int32, int32)->int32', { lazy => 1, eager => 1 } ) }, qr[Unknown option],
+        'options are checked up front';
+    like dies { wrap( $lib_path, 'apply', '(*((int32)->int32), int32)->int32', { lazy => 1, pure => 1 } ) },
+        qr[only take numbers and strings], '...and so are the arguments of a pure binding';
+    like dies { wrap( $lib_path, 'twice', '(int32)->int32', { lazy => 1, pure => 1, cache_size => 0 } ) },
+        qr[at least 1], '...and its cache size';
+    undef $missing;
+    ok lives { wrap( $lib_path, 'add', '(int32, int32)->int32', { lazy => 1 } ) }, 'unused lazy bindings are freed';
+};
+#
+done_testing;
@@ -0,0 +1,79 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Config;
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+#
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+//ext: .c
+
+typedef struct { int x, y; } point;
+DLLEXPORT int point_sum(point p) { return p.x + p.y; }
+END_C
+#
+typedef FrozenPoint => Struct [ x => Int, y => Int ];
+typedef 'Handle';
+my $count = Affix::types();
+is freeze_types(), $count, 'freeze_types returns the number of types';
+is freeze_types(), $count, '...and may be called again';
+is scalar Affix::types(), $count, 'types in scalar context';
+ok( ( grep { $_ eq 'FrozenPoint' } Affix::types() ), 'types in list context' );
+subtest 'definitions' => sub {
+    ok lives { typedef FrozenPoint => Struct [ x => Int, y => Int ] }, 'repeating a definition is allowed';
+    ok lives { typedef 'Handle' },                                     'so is repeating a forward declaration';
+    like dies { typedef FrozenPoint => Struct [ x => Long, y => Long ] }, qr[types are frozen], 'changes are refused';
+    like dies { typedef Unfrozen => Int }, qr[types are frozen], 'so are new types';
+};
+my $point_sum = wrap( $lib_path, 'point_sum', '(@FrozenPoint)->int32' );
+is $point_sum->( { x => 2, y => 3 } ), 5, 'named types resolve';
+is Affix::sizeof('@FrozenPoint'), Affix::sizeof('{int32, int32}'), 'sizeof';
+subtest 'threads inherit the frozen types' => sub {
+    skip_all 'perl was built without ithreads' unless $Config{useithreads};
+    require threads;
+    my @results = map { $_->join } map {
+        my $n = $_;
+        threads->create(
+            sub {
+                my $local  = wrap( $lib_path, 'point_sum', '(@FrozenPoint)->int32' );
+                my $frozen = ( dies { typedef Unfrozen => Int } ) // '';
+                [   $point_sum->( { x => $n, y => 1 } ),
+                    $local->( { x => $n, y => 2 } ),
+                    scalar Affix::types(),
+                    $frozen =~ /types are frozen/ ? 1 : 0
+                ];
+            }
+        );
+    } 1 .. 3;
+    is \@results, [ map { [ $_ + 1, $_ + 2, $count, 1 ] } 1 .. 3 ], 'bindings, new binds and the freeze in each thread';
+};
+subtest 'threads parse against the frozen types at once' => sub {
+    skip_all 'perl was built without ithreads' unless $Config{useithreads};
+    require threads;
+    require threads::shared;
+    my $ready = 0;
+    threads::shared::share($ready);
+    my @threads = map {
+        my $n = $_;
+        threads->create(
+            sub {
+                {    # Start parsing together
+                    lock $ready;
+                    $ready++;
+                    threads::shared::cond_broadcast($ready);
+                    threads::shared::cond_wait($ready) until $ready == 2;
+                }
+                my $sum = 0;
+                for my $i ( 1 .. 200 ) {
+                    $sum += Affix::sizeof("[$i:\@FrozenPoint]") / Affix::sizeof('@FrozenPoint');
+                    $sum -= wrap( $lib_path, 'point_sum', '(@FrozenPoint)->int32' )->( { x => $i, y => $n } ) - $n;
+                }
+                $sum + scalar Affix::types();
+            }
+        );
+    } 1 .. 2;
+    is [ map { $_->join } @threads ], [ $count, $count ], 'both threads see every type';
+};
+#
+done_testing;
@@ -0,0 +1,58 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Config;
+use Cwd qw[];
+use File::Temp qw[tempdir];
+use File::Copy qw[copy];
+my $libs;
+
+BEGIN {
+    # Read on the first lookup, so set it before anything looks a library up.
+    $libs                   = tempdir( CLEANUP => 1 );
+    $ENV{LD_LIBRARY_PATH}   = join ':', $libs, $ENV{LD_LIBRARY_PATH} // ();
+    $ENV{DYLD_LIBRARY_PATH} = $libs if $^O eq 'darwin';
+}
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+my $cache = $ENV{AFFIX_CACHE_DIR};    # Set by Test2::Tools::Affix unless it already was
+skip_all 'library directories come from the system on Windows' if $^O eq 'MSWin32';
+#
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+//ext: .c
+
+DLLEXPORT int answer(void) { return 42; }
+END_C
+#
+my $so = $^O eq 'darwin' ? 'dylib' : $Config{so};
+copy( $lib_path, $^O eq 'darwin' ? "$libs/libaffixindex.1.2.$so" : "$libs/libaffixindex.$so.1.2" ) or die $!;
+subtest 'lookups' => sub {
+    like Affix::locate_lib( 'affixindex', undef ), qr[libaffixindex], 'found in LD_LIBRARY_PATH';
+    ok -f "$cache/libraries-$Config{archname}.idx", 'index written';
+    like Affix::locate_lib( 'affixindex', '1.2' ), qr[libaffixindex], 'by version';
+    is [ Affix::locate_libs( 'affixindex', '9' ) ], [], 'other versions are not';
+    is wrap( Affix::locate_lib( 'affixindex', undef ), 'answer', '()->int32' )->(), 42, 'bindable';
+};
+subtest 'a changed directory is rescanned' => sub {
+    copy( $lib_path, "$libs/libaffixlate.$so" ) or die $!;
+    utime time + 10, time + 10, $libs;
+    like Affix::locate_lib( 'affixlate', undef ), qr[libaffixlate], 'found after the index was built';
+};
+subtest 'the working directory' => sub {
+    my $cwd  = Cwd::getcwd();
+    my $here = tempdir( CLEANUP => 1 );
+    copy( $lib_path, "$here/libaffixhere.$so" ) or die $!;
+    chdir $here or die $!;
+    like Affix::locate_lib( 'affixhere', undef ), qr[libaffixhere], 'searched when binding by name';
+    is [ find_library('affixhere') ], [], 'never by find_library';
+    chdir $cwd;
+};
+if ( $^O eq 'linux' && -r '/etc/ld.so.cache' ) {
+    require Affix::Platform::Unix;
+    my @paths = Affix::Platform::Unix::_ld_so_cache();
+    ok scalar(@paths), 'ld.so.cache parsed';
+    ok( ( grep {m[/libc\.so\.\d+$]} @paths ), 'libc is listed' );
+}
+#
+done_testing;
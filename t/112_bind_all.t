@@ -0,0 +1,76 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+#
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+//ext: .c
+
+typedef struct { int x, y; } point;
+static int calls = 0;
+DLLEXPORT int call_count(void) { return calls; }
+DLLEXPORT int add(int a, int b) { calls++; return a + b; }
+DLLEXPORT int sub(int a, int b) { calls++; return a - b; }
+DLLEXPORT double scale(double v, int by) { return v * by; }
+DLLEXPORT int manhattan(point * p) { return abs(p->x) + abs(p->y); }
+DLLEXPORT int count_args(int n, ...) { return n; }
+END_C
+#
+typedef BulkPoint => Struct [ x => Int, y => Int ];
+subtest 'a table of bindings' => sub {
+    my @missing = bind_all $lib_path, {
+        add        => '(int32, int32)->int32',
+        sub        => '(int32,int32) -> int32',
+        scale      => [ [ Double, Int ] => Double ],
+        manhattan  => '(*@BulkPoint)->int32',
+        count_args => '(int32;)->int32',
+        call_count => '()->int32',
+        not_there  => '()->void'
+    };
+    is \@missing, ['not_there'], 'missing symbols are returned';
+    is add( 2, 3 ),                        5,   'installed in the caller';
+    is main::sub( 5, 3 ),                  2,   'signatures that differ only in whitespace';
+    is scale( 1.5, 2 ),                    3.0, '[ \@args => $ret ]';
+    is manhattan( \{ x => -2, y => 3 } ),  5,   'named types';
+    is count_args( 2, 1, 2 ),              2,   'variadic';
+    is prototype( \&add ),                 '$$', 'prototype';
+    ok !defined &not_there, 'nothing is installed for missing symbols';
+};
+subtest 'package and options' => sub {
+    my $lib     = load_library($lib_path);
+    my @missing = bind_all $lib, { add => '(int32, int32)->int32', count_args => '(int32;)->int32' }, package => 'Bulk::Lazy', lazy => 1;
+    is \@missing, [], 'nothing missing';
+    undef $lib;
+    my $before = call_count();
+    is Bulk::Lazy::add( 1, 2 ),           3, 'lazy binding in the named package';
+    is Bulk::Lazy::count_args( 3, 1, 2, 3 ), 3, 'variadic functions are bound up front';
+    is call_count() - $before, 1, 'reached C';
+    bind_all $lib_path, { add => '(int32, int32)->int32' }, package => 'Bulk::Pure', pure => 1;
+    $before = call_count();
+    is Bulk::Pure::add( 4, 4 ), 8, 'first call';
+    is Bulk::Pure::add( 4, 4 ), 8, 'cached';
+    is call_count() - $before, 1, 'pure';
+};
+subtest 'errors' => sub {
+    like dies { bind_all $lib_path, { add => '(int32, int32)->int32' }, eager => 1 }, qr[Unknown option], 'options are checked';
+    like dies { bind_all 'no_such_library_12345', {} }, qr[Failed to load library], 'missing library';
+    like dies { bind_all $lib_path, { add => [ [Int] ] } }, qr[must be a signature], 'malformed entries';
+    like dies { bind_all $lib_path, { count_args => '(int32;)->int32' }, pure => 1 }, qr[not supported for variadic],
+        'variadic bindings reject options';
+    like dies {
+        bind_all $lib_path, { add => '(int32, int32)->int32', manhattan => '(*@BulkPoint)->int32' }, package => 'Bulk::Bad', pure => 1
+    }, qr[manhattan.+pure function], 'each binding is checked';
+    ok !defined &Bulk::Bad::add, '...before any is installed';
+    like dies {
+        bind_all $lib_path, { add => '(int32, int32)->int32', manhattan => '(*@BulkPoint)->int32' }, package => 'Bulk::Bad', pure => 1,
+            lazy => 1
+    }, qr[manhattan.+pure function], 'lazy ones too';
+    ok !defined &Bulk::Bad::add, '...before any is installed';
+    like dies { bind_all $lib_path, { add => '(int32, int32)->int32', sub => '(int32, nope)->int32' }, package => 'Bulk::Bad' },
+        qr[parse], 'bad signatures';
+    ok !defined &Bulk::Bad::add, '...leave nothing bound either';
+};
+#
+done_testing;
@@ -0,0 +1,82 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+use Affix::AOT;
+use ExtUtils::CBuilder;
+use File::Temp qw[tempdir];
+#
+skip_all 'no C compiler' unless ExtUtils::CBuilder->new( quiet => 1 )->have_compiler;
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+//ext: .c
+
+typedef struct { int x, y; } point;
+static int calls = 0;
+DLLEXPORT int add(int a, int b) { return a + b; }
+DLLEXPORT double scale(double v, float by) { return v * by; }
+DLLEXPORT uint64_t biggest(void) { return UINT64_MAX; }
+DLLEXPORT bool is_even(int8_t v) { return v % 2 == 0; }
+DLLEXPORT size_t length(const char * s) { return s == NULL ? 0 : strlen(s); }
+DLLEXPORT const char * greet(int which) { return which ? "hello" : NULL; }
+DLLEXPORT void bump(void) { calls++; }
+DLLEXPORT int call_count(void) { return calls; }
+DLLEXPORT int manhattan(point * p) { return abs(p->x) + abs(p->y); }
+END_C
+#
+my %table = (
+    lib      => $lib_path,
+    package  => 'AOT::Test',
+    types    => [ AOTPoint => Struct [ x => Int, y => Int ] ],
+    bindings => {
+        add        => [ [ Int, Int ] => Int ],
+        scale      => '(double, float)->double',
+        biggest    => '()->uint64',
+        is_even    => '(sint8)->bool',
+        length     => '(*char)->size_t',
+        greet      => '(int)->*char',
+        bump       => '()->void',
+        call_count => '()->int32',
+        manhattan  => '(*@AOTPoint)->int32',
+        missing    => '()->void'
+    }
+);
+subtest 'generate' => sub {
+    my $generated = Affix::AOT::generate(%table);
+    is $generated->{native}, [qw[add biggest bump call_count greet is_even length missing scale]], 'native wrappers';
+    is $generated->{fallback}, ['manhattan'], 'the rest is left to the JIT';
+    like $generated->{c},  qr[XS_EXTERNAL\(boot_AOT__Test\)], 'boot function';
+    like $generated->{pm}, qr['manhattan' => '\(\*\@AOTPoint\)->int32'], 'fallback bindings are listed';
+    unlike $generated->{pm}, qr['add'], '...native ones are not';
+    like dies { Affix::AOT::generate( %table, package => 'Not A Package' ) }, qr[Invalid package name], 'package names are checked';
+};
+subtest 'build and load' => sub {
+    my $dir   = tempdir( CLEANUP => 1 );
+    my $built = Affix::AOT::build( $dir, %table );
+    ok -f $built->{lib}, 'module built';
+    ok -f $built->{pm},  'loader written';
+    unshift @INC, $dir;
+    ok lives { require AOT::Test }, 'loads';
+    is prototype( \&AOT::Test::add ), '$$', 'prototype';
+    is AOT::Test::add( 2, 3 ),       5,          'int';
+    is AOT::Test::scale( 1.5, 2 ),   3,          'double and float';
+    is AOT::Test::biggest(),         ~0,         'uint64';
+    ok AOT::Test::is_even(4),        'bool true';
+    ok !AOT::Test::is_even(3),       'bool false';
+    is AOT::Test::length('four'),    4,          'string argument';
+    is AOT::Test::length(undef),     0,          'undef is NULL';
+    my $pin = Affix::malloc( Affix::sizeof('[8:char]') );
+    $pin->cast('[8:char]');
+    $$pin = 'pinned';
+    is AOT::Test::length($pin),      6,          'pins pass their pointer';
+    is AOT::Test::greet(1),          'hello',    'string return';
+    is AOT::Test::greet(0),          U(),        'NULL is undef';
+    is [ AOT::Test::bump() ],        [ U() ],    'void returns undef';
+    is AOT::Test::call_count(),      1,          'void call reached C';
+    is AOT::Test::manhattan( \{ x => -2, y => 3 } ), 5, 'fallback binding with a replayed type';
+    like dies { AOT::Test::add(1) },   qr[Wrong number of arguments], 'argument count is checked';
+    like dies { AOT::Test::missing() }, qr[missing],                  'missing symbols are reported when called';
+};
+#
+done_testing;
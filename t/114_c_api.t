@@ -0,0 +1,130 @@
+use v5.40;
+use lib '../lib', 'lib';
+use blib;
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+use Config;
+use DynaLoader;
+use ExtUtils::CBuilder;
+use File::Basename qw[dirname];
+use File::Temp     qw[tempdir];
+#
+my $builder = ExtUtils::CBuilder->new( quiet => 1 );
+skip_all 'no C compiler' unless $builder->have_compiler;
+my $lib_path = compile_ok(<<'END_C');
+#include "std.h"
+//ext: .c
+
+DLLEXPORT int add(int a, int b) { return a + b; }
+DLLEXPORT double scale(double v, int by) { return v * by; }
+DLLEXPORT int total(const int * v, int n) {
+    int sum = 0;
+    for (int i = 0; i < n; i++)
+        sum += v[i];
+    return sum;
+}
+END_C
+affix $lib_path, 'add', '(int32, int32)->int32';
+affix $lib_path, [ add => 'lazy_add' ], '(int32, int32)->int32', { lazy => 1 };
+my $scale = wrap $lib_path, 'scale', '(double, int32)->double';
+my $total = wrap $lib_path, 'total', '(*int32, int32)->int32';
+
+# A small XS module using nothing but Affix/API.h
+my $dir = tempdir( CLEANUP => 1 );
+my $c   = "$dir/capi.c";
+open my $fh, '>', $c or die $!;
+print $fh <<'END_XS';
+#define PERL_NO_GET_CONTEXT 1
+#include <EXTERN.h>
+#include <perl.h>
+#include <XSUB.h>
+#include "Affix/API.h"
+
+XS_INTERNAL(capi_add) {
+    dXSARGS;
+    if (items != 3)
+        croak_xs_usage(cv, "name, a, b");
+    const affix_api * api = affix_api_fetch(aTHX);
+    affix_binding * add = api->binding_find(aTHX_ SvPV_nolen(ST(0)));
+    if (add == NULL)
+        XSRETURN_UNDEF;
+    int a = (int)SvIV(ST(1)), b = (int)SvIV(ST(2)), sum;
+    void * args[] = {&a, &b};
+    api->binding_call(add, &sum, args);
+    XSRETURN_IV(sum);
+}
+XS_INTERNAL(capi_call) {
+    dXSARGS;
+    const affix_api * api = affix_api_fetch(aTHX);
+    affix_binding * binding = api->binding_from_sv(aTHX_ ST(0));
+    size_t count = api->binding_num_args(binding);
+    if ((size_t)items != count + 1)
+        croak("expected %d arguments", (int)count);
+    void ** args = (void **)alloca(count * sizeof(void *));
+    for (size_t i = 0; i < count; i++) {
+        const affix_type * type = api->binding_arg_type(binding, i);
+        args[i] = alloca(api->type_size(type));
+        api->sv_to_c(aTHX_ ST(i + 1), type, args[i]);
+    }
+    const affix_type * ret_type = api->binding_return_type(binding);
+    void * ret = alloca(api->type_size(ret_type));
+    api->binding_call(binding, ret, args);
+    SV * out = sv_newmortal();
+    api->c_to_sv(aTHX_ ret, ret_type, out);
+    ST(0) = out;
+    XSRETURN(1);
+}
+XS_INTERNAL(capi_round_trip) {
+    dXSARGS;
+    if (items != 2)
+        croak_xs_usage(cv, "signature, value");
+    const affix_api * api = affix_api_fetch(aTHX);
+    affix_type_ref * ref = api->type_parse(aTHX_ SvPV_nolen(ST(0)));
+    const affix_type * type = api->type_graph(ref);
+    void * buffer = safecalloc(1, api->type_size(type));
+    api->sv_to_c(aTHX_ ST(1), type, buffer);
+    SV * out = sv_newmortal();
+    api->c_to_sv(aTHX_ buffer, type, out);
+    safefree(buffer);
+    api->type_release(ref);
+    ST(0) = out;
+    XSRETURN(1);
+}
+XS_INTERNAL(capi_version) {
+    dXSARGS;
+    PERL_UNUSED_VAR(items);
+    XSRETURN_UV(affix_api_fetch(aTHX)->version);
+}
+XS_EXTERNAL(boot_CAPI__Test) {
+    dXSARGS;
+    PERL_UNUSED_VAR(items);
+    newXS("CAPI::Test::add", capi_add, __FILE__);
+    newXS("CAPI::Test::call", capi_call, __FILE__);
+    newXS("CAPI::Test::round_trip", capi_round_trip, __FILE__);
+    newXS("CAPI::Test::version", capi_version, __FILE__);
+    XSRETURN_YES;
+}
+END_XS
+close $fh;
+my $so = eval {
+    my $obj = $builder->compile( source => $c, include_dirs => [ dirname $INC{'Affix.pm'} ] );
+    $builder->link( objects => [$obj], lib_file => "$dir/capi.$Config{dlext}", module_name => 'CAPI::Test' );
+} or skip_all "Failed to build the test module: $@";
+my $libref = DynaLoader::dl_load_file( $so, 0 ) or die DynaLoader::dl_error();
+DynaLoader::dl_install_xsub( 'CAPI::Test::bootstrap', DynaLoader::dl_find_symbol( $libref, 'boot_CAPI__Test' ) )->('CAPI::Test');
+#
+ok CAPI::Test::version() >= 1, 'table is published';
+subtest 'bindings' => sub {
+    is CAPI::Test::add( 'main::add', 2, 3 ), 5, 'found by name and called with C arguments';
+    is CAPI::Test::add( 'main::lazy_add', 4, 5 ), 9, 'lazy bindings are resolved';
+    is CAPI::Test::add( 'main::is', 1, 1 ), U(), 'other subs are not bindings';
+    is CAPI::Test::call( $scale, 1.5, 4 ), 6, 'argument and return types drive the marshalling';
+    is CAPI::Test::call( $total, [ 1 .. 4 ], 4 ), 10, 'arrays are copied into a buffer for pointers';
+};
+subtest 'types' => sub {
+    is CAPI::Test::round_trip( 'int16', 70000 ), 4464, 'integers are truncated as for an argument';
+    is CAPI::Test::round_trip( '{x:int32,y:double}', { x => 3, y => 1.5 } ), { x => 3, y => 1.5 }, 'structs';
+    like dies { CAPI::Test::round_trip( '{x:', 1 ) }, qr[for the C API], 'parse errors croak';
+};
+#
+done_testing;
@@ -0,0 +1,97 @@
+use v5.40;
+use lib '../lib', 'lib';
+use File::Temp qw[tempdir];
+use blib;
+use Test2::Tools::Affix qw[:all];
+use Affix               qw[:all];
+use Path::Tiny          qw[path];
+#
+my $cache = tempdir( CLEANUP => 1 );    # Counted below, so not whatever AFFIX_CACHE_DIR holds
+my $dir   = path( tempdir( CLEANUP => 1 ) );
+$dir->child('inc')->mkpath;
+$dir->child( 'inc', 'answer.h' )->spew_raw("#define ANSWER 42\n");
+my $src = $dir->child('answer.c');
+$src->spew_raw(qq[#include "answer.h"\nint answer(void) { return ANSWER; }\n]);
+my $obj = $src->sibling( 'answer' . $Config::Config{_o} );
+
+sub build (%args) {
+    $obj->remove;
+    my $compiler = Affix::Compiler->new(
+        name         => 'answer',
+        source       => ["$src"],
+        include_dirs => [ $dir->child('inc')->stringify ],
+        cache        => $cache,
+        %args
+    );
+    $compiler->compile;
+    my $lib = $compiler->link // return;
+    return { lib => "$lib", compiled => $obj->exists };
+}
+
+sub entries ($kind) { my @entries = path($cache)->child( 'compiler', $kind )->children; scalar @entries }
+subtest 'reused across builds' => sub {
+    my $first = build();
+    ok $first->{compiled}, 'first build compiles';
+    is wrap( $first->{lib}, 'answer', '()->int' )->(), 42, 'and works';
+    is entries('objects'), 1, 'object cached';
+    is entries('libs'),    1, 'library cached';
+    my $second = build();
+    ok !$second->{compiled}, 'second build does not';
+    isnt $second->{lib}, $first->{lib}, 'each build still gets its own copy';
+    is wrap( $second->{lib}, 'answer', '()->int' )->(), 42, 'which works';
+    is entries('objects'), 1, 'nothing new cached';
+};
+subtest 'invalidation' => sub {
+    $dir->child( 'inc', 'answer.h' )->spew_raw("#define ANSWER 43\n");
+    my $header = build();
+    ok $header->{compiled}, 'a changed header rebuilds';
+    is wrap( $header->{lib}, 'answer', '()->int' )->(), 43, 'with the new value';
+    ok build( flags => { cflags => '-O2' } )->{compiled}, 'so do new flags';
+    $src->spew_raw(qq[#include "answer.h"\nint answer(void) { return ANSWER + 1; }\n]);
+    ok build()->{compiled}, 'and a changed source';
+    ok !build()->{compiled}, '...once';
+};
+subtest 'headers outside the include dirs' => sub {
+    $dir->child('near.h')->spew_raw("#define NEAR 1\n");
+    $dir->child( 'inc', 'nested' )->mkpath;
+    $dir->child( 'inc', 'nested', 'deep.h' )->spew_raw("#define DEEP 10\n");
+    $src->spew_raw(qq[#include "near.h"\n#include <nested/deep.h>\nint answer(void) { return NEAR + DEEP; }\n]);
+    my $first = build();
+    ok $first->{compiled}, 'compiled';
+    is wrap( $first->{lib}, 'answer', '()->int' )->(), 11, 'and works';
+    ok !build()->{compiled}, 'cached';
+    $dir->child('near.h')->spew_raw("#define NEAR 2\n");
+    my $near = build();
+    ok $near->{compiled}, 'a changed header next to the source rebuilds';
+    is wrap( $near->{lib}, 'answer', '()->int' )->(), 12, 'with the new value';
+    $dir->child( 'inc', 'nested', 'deep.h' )->spew_raw("#define DEEP 20\n");
+    my $deep = build();
+    ok $deep->{compiled}, 'so does one in a nested directory';
+    is wrap( $deep->{lib}, 'answer', '()->int' )->(), 22, 'with the new value';
+    ok !build()->{compiled}, '...once';
+};
+subtest 'bounded' => sub {
+    ok entries('objects') > 1, 'several objects cached';
+    $src->spew_raw(qq[#include "answer.h"\nint answer(void) { return ANSWER + 2; }\n]);
+    my $built = build( cache_limit => 1 );
+    is wrap( $built->{lib}, 'answer', '()->int' )->(), 45, 'an over-full cache still builds';
+    is entries('objects'), 1, 'older objects are evicted';
+    is entries('libs'),    1, 'older libraries are evicted';
+};
+ok build( cache => 0 )->{compiled}, 'cache => 0 always compiles';
+subtest 'compile_ok uses AFFIX_CACHE_DIR' => sub {
+    my $objects = path( $ENV{AFFIX_CACHE_DIR} )->child( 'compiler', 'objects' );
+    my @counts;
+    for ( 1 .. 2 ) {    # The same call, so the same source
+        ok compile_ok(<<'END_C'), 'built';
+#include "std.h"
+//ext: .c
+
+DLLEXPORT int cached_twice(void) { return 2; }
+END_C
+        push @counts, scalar $objects->children;
+    }
+    is $counts[1], $counts[0], 'the second build is a cache hit';
+};
+#
+done_testing;